@@ -0,0 +1,117 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <cmath>
+
+//==============================================================================
+// Control-rate analogue character: slow pitch drift, cutoff wander and fixed
+// per-voice component variance.
+//
+// The motion comes from one precomputed trajectory shared by every voice:
+// smooth value noise (three octaves, periods of 8, 4 and 2 s at the default
+// read rate). Each voice reads it at its own offset and a slightly different
+// speed for pitch and for cutoff, so voices move independently without a
+// single random call after prepare(). advance() runs once per engine
+// micro-block; the per-sample code only multiplies by the cached results.
+//==============================================================================
+class AnalogDrift
+{
+public:
+    AnalogDrift()
+    {
+        trajectory();   // build the shared table here, not on the audio thread
+    }
+
+    /** voiceIndex is the voice's slot in its engine: it alone seeds the
+        component variance and trajectory offsets, so a voice sounds the same
+        in every instance and every time a session is recalled. */
+    void prepare (double sampleRate, int voiceIndex) noexcept
+    {
+        invSampleRate = 1.0 / sampleRate;
+
+        juce::Random r (0x5eed + 977 * voiceIndex);
+
+        cutoffTol    = 1.0f + (r.nextFloat() - 0.5f) * 0.04f;     // ±2 %
+        resonanceTol = 1.0f + (r.nextFloat() - 0.5f) * 0.10f;     // ±5 %
+        pitchTrim    = (r.nextFloat() - 0.5f) * 0.001f;           // ±0.05 % (≈ ±0.9 cent)
+
+        pitchPos  = r.nextFloat() * tableSize;
+        cutoffPos = r.nextFloat() * tableSize;
+        pitchRate = pointsPerSecond * (0.85f + 0.3f * r.nextFloat());
+        cutRate   = pointsPerSecond * (0.85f + 0.3f * r.nextFloat());
+    }
+
+    /** Step both trajectories by numSamples worth of time. */
+    void advance (int numSamples) noexcept
+    {
+        const double seconds = numSamples * invSampleRate;
+        pitchPos  = wrap (pitchPos  + pitchRate * seconds);
+        cutoffPos = wrap (cutoffPos + cutRate   * seconds);
+    }
+
+    /** Frequency multiplier for ANA_DRIFT: calibration trim + ±0.15 % wander. */
+    float getPitchRatio() const noexcept   { return 1.0f + pitchTrim + 0.0015f * read (pitchPos); }
+
+    /** Cutoff multiplier for ANA_FILT_TOL: component tolerance + ±3 % wander. */
+    float getCutoffScale() const noexcept  { return cutoffTol * (1.0f + 0.03f * read (cutoffPos)); }
+    float getResonanceScale() const noexcept { return resonanceTol; }
+
+private:
+    static constexpr int    tableSize       = 1024;
+    static constexpr double pointsPerSecond = 8.0;
+
+    using Table = std::array<float, tableSize>;
+
+    static const Table& trajectory()
+    {
+        static const Table table = []
+        {
+            Table t {};
+            juce::Random r (0xd71f7);
+
+            // value noise: random control points every `period` entries,
+            // smoothstep-interpolated, summed over three octaves
+            float amp = 1.0f;
+            for (int period = 64; period >= 16; period /= 2, amp *= 0.5f)
+            {
+                const int numPoints = tableSize / period;
+                std::array<float, tableSize / 16> pts {};
+                for (int i = 0; i < numPoints; ++i)
+                    pts[(size_t) i] = r.nextFloat() * 2.0f - 1.0f;
+
+                for (int i = 0; i < tableSize; ++i)
+                {
+                    const int   k = i / period;
+                    const float f = float (i % period) / float (period);
+                    const float s = f * f * (3.0f - 2.0f * f);
+                    const float a = pts[(size_t) k];
+                    const float b = pts[(size_t) ((k + 1) % numPoints)];   // wraps seamlessly
+                    t[(size_t) i] += amp * (a + s * (b - a));
+                }
+            }
+
+            float peak = 0.0f;
+            for (auto v : t) peak = juce::jmax (peak, std::abs (v));
+            for (auto& v : t) v /= peak;                                   // ±1
+            return t;
+        }();
+        return table;
+    }
+
+    static double wrap (double pos) noexcept { return pos >= tableSize ? pos - tableSize : pos; }
+
+    static float read (double pos) noexcept
+    {
+        const auto& t = trajectory();
+        const int   i = (int) pos;
+        const float f = float (pos - i);
+        const float a = t[(size_t) i];
+        const float b = t[(size_t) ((i + 1) & (tableSize - 1))];
+        return a + f * (b - a);
+    }
+
+    double invSampleRate = 1.0 / 44100.0;
+    double pitchPos = 0.0, cutoffPos = 0.0;
+    double pitchRate = pointsPerSecond, cutRate = pointsPerSecond;
+    float  pitchTrim = 0.0f, cutoffTol = 1.0f, resonanceTol = 1.0f;
+};
@@ -0,0 +1,223 @@
+#include "AnalogEnvelope.h"
+#include <cmath>
+
+//----------------------------------------------------------------------
+// setup
+void AnalogEnvelope::setSampleRate (double newSampleRate) noexcept
+{
+    sampleRate = newSampleRate;
+}
+
+void AnalogEnvelope::setParameters (const Parameters& newParameters, bool analogCurves) noexcept
+{
+    const bool changed = analogCurves        != analog
+                      || newParameters.attack  != params.attack
+                      || newParameters.decay   != params.decay
+                      || newParameters.sustain != params.sustain
+                      || newParameters.release != params.release;
+    if (! changed)
+        return;
+
+    params = newParameters;
+    analog = analogCurves;
+
+    // Re-plan whatever segment is running from where the level is now
+    if (forced)
+        return;
+
+    switch (state)
+    {
+        case State::attack:
+        case State::decay:
+        case State::release:  enter (state);             break;
+        case State::sustain:  level = params.sustain;    break;
+        case State::idle:     break;
+    }
+}
+
+int AnalogEnvelope::samplesFor (float seconds) const noexcept
+{
+    return juce::jmax (1, (int) std::lround (seconds * sampleRate));
+}
+
+//----------------------------------------------------------------------
+// note events
+void AnalogEnvelope::noteOn() noexcept
+{
+    forced = false;
+
+    if (params.attack > 0.0f)
+        enter (State::attack);
+    else if (params.decay > 0.0f)
+    {
+        level = 1.0f;
+        enter (State::decay);
+    }
+    else
+    {
+        level = params.sustain;
+        state = State::sustain;
+    }
+}
+
+void AnalogEnvelope::noteOff() noexcept
+{
+    if (state == State::idle)
+        return;
+
+    if (params.release > 0.0f)
+        enter (State::release);
+    else
+        reset();
+}
+
+void AnalogEnvelope::quickRelease (float seconds) noexcept
+{
+    if (state == State::idle)
+        return;
+
+    if (level <= 0.0f)
+    {
+        reset();
+        return;
+    }
+
+    state      = State::release;
+    forced     = true;
+    expSegment = false;
+    endLevel   = 0.0f;
+    remaining  = samplesFor (seconds);
+    rate       = -level / (float) remaining;
+}
+
+void AnalogEnvelope::reset() noexcept
+{
+    state     = State::idle;
+    level     = 0.0f;
+    remaining = 0;
+    forced    = false;
+}
+
+//----------------------------------------------------------------------
+// segment planning – closed-form lengths for both curve shapes
+void AnalogEnvelope::enter (State newState) noexcept
+{
+    state = newState;
+
+    float seconds = 0.0f, overshoot = 0.0f;
+    switch (newState)
+    {
+        case State::attack:  endLevel = 1.0f;           seconds = params.attack;  overshoot = attackOvershoot;  break;
+        case State::decay:   endLevel = params.sustain; seconds = params.decay;   overshoot = decayOvershoot;   break;
+        case State::release: endLevel = 0.0f;           seconds = params.release; overshoot = decayOvershoot;   break;
+        case State::sustain: level = params.sustain;    return;
+        case State::idle:    reset();                   return;
+    }
+
+    const int   n     = samplesFor (seconds);
+    const float start = (newState == State::decay) ? 1.0f : (newState == State::attack ? 0.0f : level);
+    const float span  = endLevel - start;                         // full-scale travel
+
+    // Nothing to travel: jump straight to the next stage
+    if (std::abs (endLevel - level) < 1.0e-6f || std::abs (span) < 1.0e-6f)
+    {
+        remaining = 0;
+        finishSegment();
+        return;
+    }
+
+    expSegment = analog;
+
+    if (! expSegment)
+    {
+        // juce::ADSR timing: full-scale slope for A/D, current level for R
+        rate      = span / (float) n;
+        remaining = juce::jmax (1, (int) std::ceil ((endLevel - level) / rate));
+        return;
+    }
+
+    // RC: asymptote past the end by `overshoot` of the travel, pole chosen so
+    // start → end takes n samples; the current level may be part-way already.
+    target = endLevel + span * overshoot;
+    const float ratio = (endLevel - target) / (start - target);   // (0, 1)
+    coef = (float) std::pow ((double) ratio, 1.0 / n);
+
+    const double fromHere = (double) (endLevel - target) / (double) (level - target);
+    remaining = (fromHere <= 0.0 || fromHere >= 1.0)
+                    ? 1
+                    : juce::jmax (1, (int) std::ceil (std::log (fromHere) / std::log ((double) coef)));
+}
+
+void AnalogEnvelope::finishSegment() noexcept
+{
+    level = endLevel;
+
+    switch (state)
+    {
+        case State::attack:   enter (params.decay > 0.0f ? State::decay : State::sustain); break;
+        case State::decay:    state = State::sustain; level = params.sustain;              break;
+        case State::release:  reset();                                                     break;
+        default:              break;
+    }
+}
+
+//----------------------------------------------------------------------
+// block render
+void AnalogEnvelope::render (float* dest, int numSamples) noexcept
+{
+    while (numSamples > 0)
+    {
+        if (state == State::idle)
+        {
+            juce::FloatVectorOperations::clear (dest, numSamples);
+            return;
+        }
+
+        if (state == State::sustain)
+        {
+            juce::FloatVectorOperations::fill (dest, params.sustain, numSamples);
+            level = params.sustain;
+            return;
+        }
+
+        const int n = juce::jmin (numSamples, remaining);
+
+        if (expSegment)
+        {
+            // y[i] = target + off·coef^(i+1), four powers per step
+            const float c1 = coef, c2 = c1 * c1, c3 = c2 * c1, c4 = c2 * c2;
+            float off = level - target;
+            int i = 0;
+            for (; i + 4 <= n; i += 4)
+            {
+                dest[i]     = target + off * c1;
+                dest[i + 1] = target + off * c2;
+                dest[i + 2] = target + off * c3;
+                dest[i + 3] = target + off * c4;
+                off *= c4;
+            }
+            for (; i < n; ++i)
+            {
+                off *= c1;
+                dest[i] = target + off;
+            }
+            level = target + off;
+        }
+        else
+        {
+            for (int i = 0; i < n; ++i)
+                dest[i] = level + rate * (float) (i + 1);
+            level += rate * (float) n;
+        }
+
+        remaining  -= n;
+        dest       += n;
+        numSamples -= n;
+
+        if (remaining <= 0)
+        {
+            dest[-1] = endLevel;   // last step lands exactly on the end
+            finishSegment();
+        }
+    }
+}
@@ -0,0 +1,75 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Block ADSR, a replacement for juce::ADSR + the old sqrt "analog" curve.
+//
+// render() writes a whole block of gains at once. Each segment is either a
+// linear ramp (same timing as juce::ADSR) or a recursive RC exponential
+//   y[n+1] = target + (y[n] - target) * coef
+// whose target overshoots the segment end, so it arrives in exactly the set
+// time (attack aims 30 % past full scale, decay/release just past their end).
+// Segment lengths are closed-form, so the inner loops have no per-sample
+// branches; the exponential runs four powers of coef side by side.
+//==============================================================================
+class AnalogEnvelope
+{
+public:
+    struct Parameters
+    {
+        float attack  = 0.1f;   // seconds
+        float decay   = 0.1f;   // seconds
+        float sustain = 1.0f;   // 0 … 1
+        float release = 0.1f;   // seconds
+    };
+
+    AnalogEnvelope() = default;
+
+    void setSampleRate (double newSampleRate) noexcept;
+    void setParameters (const Parameters& newParameters, bool analogCurves) noexcept;
+
+    void noteOn()  noexcept;
+    void noteOff() noexcept;
+    void reset()   noexcept;
+
+    /** Fade from the current level to silence in `seconds`, linearly,
+        ignoring RELEASE (used to shed voices under CPU pressure). */
+    void quickRelease (float seconds) noexcept;
+
+    bool  isActive()    const noexcept { return state != State::idle; }
+    bool  isAttacking() const noexcept { return state == State::attack; }
+    bool  isReleasing() const noexcept { return state == State::release; }
+    bool  isQuickReleasing() const noexcept { return forced && state == State::release; }
+    float getLevel()    const noexcept { return level; }
+
+    /** Write the next numSamples envelope values to dest. */
+    void render (float* dest, int numSamples) noexcept;
+
+private:
+    enum class State { idle, attack, decay, sustain, release };
+
+    void enter (State newState) noexcept;         // set up a segment from the current level
+    void finishSegment() noexcept;                // snap to the end and move on
+    int  samplesFor (float seconds) const noexcept;
+
+    Parameters params;
+    bool   analog     = false;
+    double sampleRate = 44100.0;
+
+    State  state      = State::idle;
+    float  level      = 0.0f;
+
+    // current segment
+    bool   expSegment = false;
+    float  target     = 0.0f;    // exponential asymptote
+    float  coef       = 0.0f;    // exponential pole
+    float  rate       = 0.0f;    // linear step per sample
+    float  endLevel   = 0.0f;
+    int    remaining  = 0;       // samples until endLevel
+    bool   forced     = false;   // quickRelease running, don't re-plan it
+
+    static constexpr float attackOvershoot = 0.3f;     // RC charge target 1.3
+    static constexpr float decayOvershoot  = 1.0e-3f;  // arrives at -60 dB of its travel
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (AnalogEnvelope)
+};
@@ -0,0 +1,229 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <iterator>
+
+//==============================================================================
+// BBD-style chorus / ensemble, the CHORUS_ON stage.
+//
+// One short stereo delay buffer (a ring per side) read by up to maxTaps
+// modulated taps. A tap's delay is base + slow LFO + fast LFO; each LFO is a
+// quadrature rotator with a per-tap starting phase. All taps advance
+// together on SIMD registers, and so do the delay maths and the linear
+// interpolation. Only the ring reads themselves are scalar gathers.
+//
+// Modes (CHORUS_MODE):
+//   Juno I / II – one tap per side, LFOs in anti-phase, 0.5 / 0.83 Hz
+//   Juno I+II   – the same pair, shallow and fast (vibrato-like)
+//   Ensemble    – three taps per side on a three-phase slow + fast LFO pair,
+//                 the string-machine sound
+// The ring input is soft-clipped and the wet output darkened by a one-pole
+// LP, standing in for the bucket brigade's companding and clock filters.
+//==============================================================================
+class ChorusEnsemble
+{
+public:
+    enum class Mode { JunoI = 0, JunoII, JunoBoth, Ensemble };
+
+    static constexpr int   maxTaps    = 8;
+    static constexpr float maxDelayMs = 12.0f;
+
+    void prepare (double sampleRate)
+    {
+        fs = sampleRate;
+        const int longest = (int) std::ceil (maxDelayMs * 0.001 * sampleRate) + 4;
+        ringSize = juce::nextPowerOfTwo (longest);
+        mask     = ringSize - 1;
+        memory.calloc ((size_t) (2 * ringSize));
+        wetAlpha = 1.0f - std::exp (-juce::MathConstants<float>::twoPi * wetCutoffHz / (float) fs);
+        setMode (mode, true);
+        reset();
+    }
+
+    void reset() noexcept
+    {
+        if (memory != nullptr)
+            juce::FloatVectorOperations::clear (memory.get(), 2 * ringSize);
+        pos = 0;
+        lpL = lpR = 0.0f;
+        setMode (mode, true);                 // LFOs back to their start phases
+    }
+
+    void setMode (Mode newMode, bool force = false) noexcept
+    {
+        if (newMode == mode && ! force)
+            return;
+        mode = newMode;
+
+        const auto& m = modes[juce::jlimit (0, (int) std::size (modes) - 1, (int) mode)];
+        numTaps    = m.numTaps;
+        activeVecs = (numTaps + lanes - 1) / lanes;
+
+        const float msToSamples = 0.001f * (float) fs;
+        baseDelay = m.baseMs * msToSamples;
+        slowDepth = m.slowMs * msToSamples;
+        fastDepth = m.fastMs * msToSamples;
+
+        const float slowRot = juce::MathConstants<float>::twoPi * m.slowHz / (float) fs;
+        const float fastRot = juce::MathConstants<float>::twoPi * m.fastHz / (float) fs;
+        slowRotC = std::cos (slowRot);  slowRotS = std::sin (slowRot);
+        fastRotC = std::cos (fastRot);  fastRotS = std::sin (fastRot);
+
+        // taps on one side share it at equal power (they are mostly decorrelated)
+        int perSide[2] {};
+        for (int k = 0; k < numTaps; ++k)
+            ++perSide[m.taps[k].side];
+
+        alignas (sizeof (Vec)) float c[maxTaps] {}, s[maxTaps] {}, gL[maxTaps] {}, gR[maxTaps] {};
+        for (int k = 0; k < maxTaps; ++k)
+        {
+            side[k] = 0;
+            a0[k] = a1[k] = frac[k] = 0.0f;
+            if (k >= numTaps)
+                continue;
+
+            const auto& t = m.taps[k];
+            const float phase = juce::MathConstants<float>::twoPi * t.phase;
+            c[k] = std::cos (phase);
+            s[k] = std::sin (phase);
+            side[k] = t.side;
+            (t.side == 0 ? gL[k] : gR[k]) = 1.0f / std::sqrt ((float) perSide[t.side]);
+        }
+
+        for (int v = 0; v < maxTaps / lanes; ++v)
+        {
+            slowC[v] = fastC[v] = Vec::fromRawArray (c + v * lanes);
+            slowS[v] = fastS[v] = Vec::fromRawArray (s + v * lanes);
+            gainL[v] = Vec::fromRawArray (gL + v * lanes);
+            gainR[v] = Vec::fromRawArray (gR + v * lanes);
+        }
+    }
+
+    void setMix (float m) noexcept { mix = juce::jlimit (0.0f, 1.0f, m); }
+
+    /** The longest tap; what is left in the ring when the input stops. */
+    static double getTailSeconds() noexcept { return maxDelayMs * 0.001; }
+
+    /** In place; right may be nullptr (mono in, the two sides averaged out). */
+    void process (float* left, float* right, int numSamples) noexcept
+    {
+        float* const ringL = memory.get();
+        float* const ringR = ringL + ringSize;
+        const Vec base  = Vec::expand (baseDelay);
+        const float dry = 1.0f - mix;
+
+        alignas (sizeof (Vec)) float delay[maxTaps];
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float inL = left[i];
+            const float inR = right != nullptr ? right[i] : inL;
+            ringL[pos] = saturate (inL);
+            ringR[pos] = saturate (inR);
+
+            // every tap's LFOs and delay time, a register at a time
+            for (int v = 0; v < activeVecs; ++v)
+            {
+                const auto sc = slowC[v], ss = slowS[v];
+                slowC[v] = sc * slowRotC - ss * slowRotS;
+                slowS[v] = ss * slowRotC + sc * slowRotS;
+                const auto fc = fastC[v], fsn = fastS[v];
+                fastC[v] = fc * fastRotC - fsn * fastRotS;
+                fastS[v] = fsn * fastRotC + fc * fastRotS;
+
+                (base + slowS[v] * slowDepth + fastS[v] * fastDepth).copyToRawArray (delay + v * lanes);
+            }
+
+            // scalar gathers
+            for (int k = 0; k < numTaps; ++k)
+            {
+                const int   di   = (int) delay[k];
+                const float* ring = side[k] == 0 ? ringL : ringR;
+                frac[k] = delay[k] - (float) di;
+                a0[k]   = ring[(pos - di)     & mask];
+                a1[k]   = ring[(pos - di - 1) & mask];
+            }
+
+            // interpolate and pan on registers
+            float wetL = 0.0f, wetR = 0.0f;
+            for (int v = 0; v < activeVecs; ++v)
+            {
+                const auto x0 = Vec::fromRawArray (a0 + v * lanes);
+                const auto x1 = Vec::fromRawArray (a1 + v * lanes);
+                const auto x  = x0 + Vec::fromRawArray (frac + v * lanes) * (x1 - x0);
+                wetL += (x * gainL[v]).sum();
+                wetR += (x * gainR[v]).sum();
+            }
+
+            lpL += wetAlpha * (wetL - lpL);
+            lpR += wetAlpha * (wetR - lpR);
+            pos = (pos + 1) & mask;
+
+            if (right != nullptr)
+            {
+                left[i]  = inL * dry + lpL * mix;
+                right[i] = inR * dry + lpR * mix;
+            }
+            else
+            {
+                left[i] = inL * dry + 0.5f * (lpL + lpR) * mix;
+            }
+        }
+
+        // keep the rotators on the unit circle
+        for (int v = 0; v < activeVecs; ++v)
+        {
+            const auto gs = Vec::expand (1.5f) - (slowC[v] * slowC[v] + slowS[v] * slowS[v]) * 0.5f;
+            slowC[v] = slowC[v] * gs;  slowS[v] = slowS[v] * gs;
+            const auto gf = Vec::expand (1.5f) - (fastC[v] * fastC[v] + fastS[v] * fastS[v]) * 0.5f;
+            fastC[v] = fastC[v] * gf;  fastS[v] = fastS[v] * gf;
+        }
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = (int) Vec::SIMDNumElements;
+    static_assert (maxTaps % lanes == 0, "taps must fill whole registers");
+
+    static constexpr float wetCutoffHz = 9000.0f;
+
+    struct Tap      { float phase; int side; };   // LFO start phase in cycles, 0 = left
+    struct ModeSpec
+    {
+        int   numTaps;
+        float baseMs, slowMs, slowHz, fastMs, fastHz;
+        Tap   taps[maxTaps];
+    };
+
+    //                      taps base  slowMs slowHz fastMs fastHz
+    static constexpr ModeSpec modes[] =
+    {
+        { 2, 3.5f, 1.60f, 0.51f, 0.00f, 0.0f,  { { 0.0f, 0 }, { 0.5f, 1 } } },                      // Juno I
+        { 2, 3.5f, 1.60f, 0.83f, 0.00f, 0.0f,  { { 0.0f, 0 }, { 0.5f, 1 } } },                      // Juno II
+        { 2, 3.5f, 0.30f, 9.75f, 0.00f, 0.0f,  { { 0.0f, 0 }, { 0.5f, 1 } } },                      // Juno I+II
+        { 6, 6.0f, 1.50f, 0.60f, 0.25f, 6.0f,  { { 0.0f,      0 }, { 1.0f / 3, 0 }, { 2.0f / 3, 0 },
+                                                 { 1.0f / 6, 1 }, { 0.5f,      1 }, { 5.0f / 6, 1 } } }, // Ensemble
+    };
+
+    /** Rational tanh, exact slope 1 at 0 and ±1 at |x| = 3. */
+    static float saturate (float x) noexcept
+    {
+        x = juce::jlimit (-3.0f, 3.0f, x);
+        return x * (27.0f + x * x) / (27.0f + 9.0f * x * x);
+    }
+
+    juce::HeapBlock<float> memory;        // left ring, then right ring
+    int    ringSize = 0, mask = 0, pos = 0;
+    double fs = 44100.0;
+
+    Mode  mode = Mode::JunoI;
+    int   numTaps = 2, activeVecs = 1;
+    int   side[maxTaps] {};
+    float baseDelay = 0.0f, slowDepth = 0.0f, fastDepth = 0.0f;
+    float slowRotC = 1.0f, slowRotS = 0.0f, fastRotC = 1.0f, fastRotS = 0.0f;
+    float mix = 0.5f, wetAlpha = 1.0f, lpL = 0.0f, lpR = 0.0f;
+
+    alignas (sizeof (Vec)) float a0[maxTaps] {}, a1[maxTaps] {}, frac[maxTaps] {};
+    Vec slowC[maxTaps / lanes], slowS[maxTaps / lanes], fastC[maxTaps / lanes], fastS[maxTaps / lanes];
+    Vec gainL[maxTaps / lanes], gainR[maxTaps / lanes];
+};
@@ -0,0 +1,359 @@
+#include "ConvolutionReverb.h"
+#include <cmath>
+
+//==============================================================================
+// Partitioned
+void ConvolutionReverb::Partitioned::init (const float* ir, int irLength, int blockSize)
+{
+    P        = blockSize;
+    numBins  = P + 1;
+    numParts = irLength > 0 ? (irLength + P - 1) / P : 0;
+
+    int order = 0;
+    while ((1 << order) < 2 * P)
+        ++order;
+    fft = std::make_unique<juce::dsp::FFT> (order);
+
+    const size_t slot = (size_t) numBins * 2;
+    spectra.assign ((size_t) numParts * slot, 0.0f);
+    fdl    .assign ((size_t) numParts * slot, 0.0f);
+    history.assign ((size_t) 2 * P, 0.0f);
+    work   .assign ((size_t) 4 * P, 0.0f);
+    acc    .assign (slot, 0.0f);
+    fdlPos = 0;
+
+    // each partition zero-padded to 2P and transformed once, here
+    for (int j = 0; j < numParts; ++j)
+    {
+        std::fill (work.begin(), work.end(), 0.0f);
+        const int n = juce::jmin (P, irLength - j * P);
+        std::copy (ir + j * P, ir + j * P + n, work.begin());
+        fft->performRealOnlyForwardTransform (work.data(), true);
+        std::copy (work.begin(), work.begin() + (long) slot, spectra.begin() + (long) (j * slot));
+    }
+}
+
+void ConvolutionReverb::Partitioned::clear() noexcept
+{
+    std::fill (fdl.begin(), fdl.end(), 0.0f);
+    std::fill (history.begin(), history.end(), 0.0f);
+    fdlPos = 0;
+}
+
+void ConvolutionReverb::Partitioned::process (const float* in, float* out) noexcept
+{
+    const size_t slot = (size_t) numBins * 2;
+
+    // overlap-save: transform the last 2P inputs
+    std::copy (history.begin() + P, history.end(), history.begin());
+    std::copy (in, in + P, history.begin() + P);
+    std::copy (history.begin(), history.end(), work.begin());
+    std::fill (work.begin() + 2 * P, work.end(), 0.0f);
+    fft->performRealOnlyForwardTransform (work.data(), true);
+    std::copy (work.begin(), work.begin() + (long) slot, fdl.begin() + (long) (fdlPos * slot));
+
+    // Y = Σ X[k-j] · H[j]
+    std::fill (acc.begin(), acc.end(), 0.0f);
+    float* a = acc.data();
+    for (int j = 0; j < numParts; ++j)
+    {
+        int s = fdlPos - j;
+        if (s < 0) s += numParts;
+        const float* x = fdl.data()     + s * slot;
+        const float* h = spectra.data() + j * slot;
+
+        for (int b = 0; b < 2 * numBins; b += 2)
+        {
+            a[b]     += x[b] * h[b]     - x[b + 1] * h[b + 1];
+            a[b + 1] += x[b] * h[b + 1] + x[b + 1] * h[b];
+        }
+    }
+    fdlPos = (fdlPos + 1) % numParts;
+
+    std::copy (acc.begin(), acc.end(), work.begin());
+    fft->performRealOnlyInverseTransform (work.data());
+    std::copy (work.begin() + P, work.begin() + 2 * P, out);   // the valid half
+}
+
+//==============================================================================
+ConvolutionReverb::ConvolutionReverb() = default;
+
+ConvolutionReverb::~ConvolutionReverb()
+{
+    worker.signalThreadShouldExit();
+    worker.notify();
+    worker.stopThread (2000);
+    delete live;
+    delete pending.exchange (nullptr);
+    delete retired.exchange (nullptr);
+}
+
+void ConvolutionReverb::prepare (double sampleRate)
+{
+    fs = sampleRate;
+    if (builtRate != fs && irFile.existsAsFile())
+        loadImpulseResponse (irFile);
+}
+
+//------------------------------------------------------------------------------
+bool ConvolutionReverb::loadImpulseResponse (const juce::File& wavFile)
+{
+    juce::WavAudioFormat wav;
+    std::unique_ptr<juce::MemoryMappedAudioFormatReader> reader (wav.createMemoryMappedReader (wavFile));
+    if (reader == nullptr || ! reader->mapEntireFile() || reader->lengthInSamples <= 0)
+        return false;
+
+    const int numCh  = (int) juce::jmin<unsigned int> (2, reader->numChannels);
+    const int srcLen = (int) juce::jmin<juce::int64> (reader->lengthInSamples,
+                                                      (juce::int64) (maxIrSeconds * reader->sampleRate));
+    juce::AudioBuffer<float> src (numCh, srcLen);
+    reader->read (&src, 0, srcLen, 0, true, numCh > 1);
+
+    // to the session rate
+    const double ratio = reader->sampleRate / fs;
+    juce::AudioBuffer<float> ir;
+    if (std::abs (ratio - 1.0) < 1.0e-9)
+    {
+        ir.makeCopyOf (src);
+    }
+    else
+    {
+        const int outLen = (int) std::floor (srcLen / ratio);
+        ir.setSize (numCh, outLen);
+        for (int ch = 0; ch < numCh; ++ch)
+        {
+            juce::LagrangeInterpolator interp;
+            interp.process (ratio, src.getReadPointer (ch), ir.getWritePointer (ch), outLen, srcLen, 0);
+        }
+    }
+
+    // drop the silent end (below -80 dB of the peak); it would only cost CPU
+    const float floorLevel = ir.getMagnitude (0, ir.getNumSamples()) * 1.0e-4f;
+    int end = ir.getNumSamples();
+    auto silentAt = [&] (int i)
+    {
+        for (int ch = 0; ch < numCh; ++ch)
+            if (std::abs (ir.getSample (ch, i)) > floorLevel)
+                return false;
+        return true;
+    };
+    while (end > 1 && silentAt (end - 1))
+        --end;
+    ir.setSize (numCh, end, true);
+
+    // unit energy, so wet level means the same for every IR
+    double energy = 0.0;
+    for (int ch = 0; ch < numCh; ++ch)
+        for (int i = 0; i < end; ++i)
+            energy += (double) ir.getSample (ch, i) * ir.getSample (ch, i);
+    energy /= numCh;
+    if (energy <= 0.0)
+        return false;
+    ir.applyGain ((float) (1.0 / std::sqrt (energy)));
+
+    // hand over; an older IR nobody has picked up yet is simply replaced
+    delete pending.exchange (build (ir).release());
+    irFile    = wavFile;
+    builtRate = fs;
+
+    if (! worker.isThreadRunning())
+        worker.startThread();
+    return true;
+}
+
+std::unique_ptr<ConvolutionReverb::Impulse> ConvolutionReverb::build (const juce::AudioBuffer<float>& ir) const
+{
+    auto imp = std::make_unique<Impulse>();
+    const int len     = ir.getNumSamples();
+    const int headLen = juce::jmin (len, 2 * tailBlock);
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        const float* src = ir.getReadPointer (juce::jmin (ch, ir.getNumChannels() - 1));
+        imp->head[(size_t) ch].init (src, headLen, headBlock);
+        if (len > headLen)
+            imp->tail[(size_t) ch].init (src + headLen, len - headLen, tailBlock);
+    }
+
+    for (auto& f : imp->slotFrame)
+        f.store (-1);
+
+    imp->hasTail = len > headLen;
+    imp->seconds = len / fs;
+    imp->tailAccum.assign ((size_t) 2 * tailBlock, 0.0f);
+    imp->frames   .assign ((size_t) numSlots * 2 * tailBlock, 0.0f);
+    imp->outputs  .assign ((size_t) numSlots * 2 * tailBlock, 0.0f);
+    return imp;
+}
+
+void ConvolutionReverb::service()
+{
+    auto* r = retired.load();
+    if (r != nullptr && workerBusy.load() != r)
+    {
+        retired.store (nullptr);
+        delete r;
+    }
+}
+
+//==============================================================================
+// Audio thread
+void ConvolutionReverb::reset() noexcept
+{
+    if (live == nullptr)
+        return;
+
+    for (int ch = 0; ch < 2; ++ch)
+    {
+        live->head[(size_t) ch].clear();
+        live->inFifo [(size_t) ch].fill (0.0f);
+        live->outFifo[(size_t) ch].fill (0.0f);
+    }
+    std::fill (live->tailAccum.begin(), live->tailAccum.end(), 0.0f);
+
+    // The worker clears its tail state before the frame being collected now;
+    // blocks built from older frames are no longer mixed in.
+    live->clearFrom.store (live->submitted.load());
+}
+
+void ConvolutionReverb::process (float* left, float* right, int numSamples) noexcept
+{
+    // adopt a newly built IR once the previous replaced one has been freed
+    if (pending.load() != nullptr && retired.load() == nullptr)
+    {
+        auto* old = live;
+        live = pending.exchange (nullptr);
+        current.store (live);
+        retired.store (old);
+    }
+
+    if (live == nullptr)
+    {
+        juce::FloatVectorOperations::clear (left, numSamples);
+        if (right != nullptr)
+            juce::FloatVectorOperations::clear (right, numSamples);
+        return;
+    }
+
+    auto& imp = *live;
+    for (int i = 0; i < numSamples; ++i)
+    {
+        const float inL = left[i];
+        const float inR = right != nullptr ? right[i] : inL;
+        const int   p   = imp.fifoPos;
+
+        imp.inFifo[0][(size_t) p] = inL;
+        imp.inFifo[1][(size_t) p] = inR;
+        const float wL = imp.outFifo[0][(size_t) p];
+        const float wR = imp.outFifo[1][(size_t) p];
+
+        if (right != nullptr)
+        {
+            left[i]  = wL * wetGain;
+            right[i] = wR * wetGain;
+        }
+        else
+        {
+            left[i] = 0.5f * (wL + wR) * wetGain;
+        }
+
+        if (++imp.fifoPos == headBlock)
+        {
+            imp.fifoPos = 0;
+            runHeadStep (imp);
+        }
+    }
+}
+
+void ConvolutionReverb::runHeadStep (Impulse& imp) noexcept
+{
+    for (size_t ch = 0; ch < 2; ++ch)
+        imp.head[ch].process (imp.inFifo[ch].data(), imp.outFifo[ch].data());
+
+    if (imp.hasTail)
+    {
+        // tail block k covers output time [(k+2)·T, (k+3)·T)
+        const juce::int64 t0 = imp.steps * headBlock;
+        const juce::int64 k  = t0 / tailBlock - 2;
+        if (k >= 0 && k >= imp.clearFrom.load() && imp.done.load() > k)
+        {
+            const int off = (int) (t0 % tailBlock);
+            for (size_t ch = 0; ch < 2; ++ch)
+                juce::FloatVectorOperations::add (imp.outFifo[ch].data(),
+                                                  imp.outputs.data() + ((k % numSlots) * 2 + (int) ch) * tailBlock + off,
+                                                  headBlock);
+        }
+
+        // collect the next tail frame
+        for (size_t ch = 0; ch < 2; ++ch)
+            std::copy (imp.inFifo[ch].begin(), imp.inFifo[ch].end(),
+                       imp.tailAccum.begin() + (long) ch * tailBlock + imp.tailFill);
+
+        imp.tailFill += headBlock;
+        if (imp.tailFill == tailBlock)
+        {
+            imp.tailFill = 0;
+            const juce::int64 f = imp.submitted.load();
+            // A worker numSlots frames behind may still be reading that
+            // slot: drop the frame. Its slot keeps the older frame's tag, so
+            // the worker convolves silence for it rather than stale input,
+            // and every later frame stays on its own time.
+            if (f - imp.done.load() < numSlots)
+            {
+                std::copy (imp.tailAccum.begin(), imp.tailAccum.end(),
+                           imp.frames.begin() + (long) ((f % numSlots) * 2 * tailBlock));
+                imp.slotFrame[(size_t) (f % numSlots)].store (f);
+            }
+            imp.submitted.store (f + 1);
+            worker.notify();
+        }
+    }
+
+    ++imp.steps;
+}
+
+//==============================================================================
+// Worker thread
+void ConvolutionReverb::Worker::run()
+{
+    // Woken by the audio thread once per tail frame (every tailBlock
+    // samples); with nothing pending it sleeps until the next one
+    while (! threadShouldExit())
+        if (! owner.runTailBlock())
+            wait (-1);
+}
+
+bool ConvolutionReverb::runTailBlock()
+{
+    auto* imp = current.load();
+    if (imp == nullptr)
+        return false;
+
+    // hazard pointer: service() will not free what we announce here
+    workerBusy.store (imp);
+    if (current.load() != imp || ! imp->hasTail || imp->done.load() >= imp->submitted.load())
+    {
+        workerBusy.store (nullptr);
+        return false;
+    }
+
+    const juce::int64 k  = imp->done.load();
+    const juce::int64 cf = imp->clearFrom.load();
+    if (k >= cf && imp->lastCleared < cf)
+    {
+        for (auto& t : imp->tail) t.clear();
+        imp->lastCleared = cf;
+    }
+
+    // a dropped frame (see runHeadStep) still advances the tail, as silence
+    static const std::array<float, tailBlock> silence {};
+    const int  slot  = (int) (k % numSlots);
+    const bool valid = imp->slotFrame[(size_t) slot].load() == k;
+    for (int ch = 0; ch < 2; ++ch)
+        imp->tail[(size_t) ch].process (valid ? imp->frames.data() + (slot * 2 + ch) * tailBlock : silence.data(),
+                                        imp->outputs.data() + (slot * 2 + ch) * tailBlock);
+
+    imp->done.store (k + 1);
+    workerBusy.store (nullptr);
+    return true;
+}
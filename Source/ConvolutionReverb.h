@@ -0,0 +1,141 @@
+#pragma once
+#include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+//==============================================================================
+// Non-uniform partitioned convolution reverb, the REVERB_ALGO = Convolution
+// engine.
+//
+// The impulse response is split in two:
+//   head – the first 2·tailBlock samples, in partitions of headBlock,
+//          convolved on the audio thread (uniform overlap-save FFT);
+//   tail – the rest, in partitions of tailBlock, convolved on a background
+//          thread.
+// Tail frame k (tailBlock input samples) is complete at (k+1)·T and its
+// output is first needed at (k+2)·T, so the worker always has a whole tail
+// block of slack. The audio thread never waits for it: a late block is
+// skipped, not awaited. The worker sleeps until the audio thread hands it a
+// frame, so a bypassed or unused engine costs no wake-ups.
+//
+// The wet signal comes out headBlock samples late (the head's block
+// latency). It acts as a short pre-delay and is not reported to the host.
+//
+// IRs are read through a memory-mapped WAV reader, resampled to the session
+// rate and FFT-transformed on the calling (message) thread. The finished
+// Impulse reaches the audio thread through an atomic slot, and service()
+// frees the one it replaced once the worker has let go of it.
+//==============================================================================
+class ConvolutionReverb
+{
+public:
+    static constexpr int    headBlock    = 128;
+    static constexpr int    tailBlock    = 2048;
+    static constexpr double maxIrSeconds = 10.0;
+
+    ConvolutionReverb();
+    ~ConvolutionReverb();
+
+    /** Message thread. Rebuilds the loaded IR if the rate changed. */
+    void prepare (double sampleRate);
+
+    /** Message thread: map, resample and transform a WAV; false if unreadable. */
+    bool loadImpulseResponse (const juce::File& wavFile);
+    juce::File getImpulseResponseFile() const { return irFile; }
+
+    /** Message thread (timer): free a replaced IR once nothing uses it. */
+    void service();
+
+    /** Audio thread: length of the live IR plus the head latency, 0 without one. */
+    double getTailSeconds() const noexcept
+    {
+        return live != nullptr ? live->seconds + headBlock / fs : 0.0;
+    }
+
+    /** Audio thread: forget the signal history (tail blocks in flight are dropped). */
+    void reset() noexcept;
+
+    /** Same meaning as juce::Reverb::Parameters' wet level. */
+    void setLevel (float wetLevel) noexcept { wetGain = wetLevel * wetScale; }
+
+    /** In place, input replaced by the wet signal; right may be nullptr.
+        Silent until an IR is loaded. */
+    void process (float* left, float* right, int numSamples) noexcept;
+
+private:
+    // Scales a unit-energy IR to roughly juce::Reverb's wet level
+    static constexpr float wetScale = 0.5f;
+    static constexpr int   numSlots = 8;   // tail frames in flight
+
+    //--------------------------------------------------------------------------
+    // Uniform overlap-save convolution of one channel, block size P, FFT 2P.
+    class Partitioned
+    {
+    public:
+        void init (const float* ir, int irLength, int blockSize);
+        void clear() noexcept;
+        void process (const float* in, float* out) noexcept;   // P in, P out
+        bool isEmpty() const noexcept { return numParts == 0; }
+
+    private:
+        int P = 0, numBins = 0, numParts = 0, fdlPos = 0;
+        std::unique_ptr<juce::dsp::FFT> fft;
+        std::vector<float> spectra;   // numParts × numBins complex (re, im)
+        std::vector<float> fdl;       // input spectra, same layout, ring of numParts
+        std::vector<float> history;   // last 2P input samples
+        std::vector<float> work;      // FFT buffer, 4P floats
+        std::vector<float> acc;       // numBins complex
+    };
+
+    //--------------------------------------------------------------------------
+    // One loaded IR with all the state that runs it. Built on the message
+    // thread; afterwards the audio thread owns the head, the worker the tail.
+    struct Impulse
+    {
+        std::array<Partitioned, 2> head, tail;
+        bool hasTail = false;
+        double seconds = 0.0;                            // IR length
+
+        // audio thread
+        std::array<std::array<float, headBlock>, 2> inFifo {}, outFifo {};
+        int  fifoPos = 0, tailFill = 0;
+        juce::int64 steps = 0;
+        std::vector<float> tailAccum;                    // 2 × T
+
+        // audio → worker frames, worker → audio output blocks
+        std::vector<float> frames, outputs;              // numSlots × 2 × T each
+        std::atomic<juce::int64> submitted { 0 }, done { 0 };
+        std::array<std::atomic<juce::int64>, numSlots> slotFrame;   // frame each slot holds
+        std::atomic<juce::int64> clearFrom { 0 };        // set by reset()
+        juce::int64 lastCleared = 0;                     // worker only
+    };
+
+    class Worker : public juce::Thread
+    {
+    public:
+        explicit Worker (ConvolutionReverb& o) : juce::Thread ("Convolution tail"), owner (o) {}
+        void run() override;
+    private:
+        ConvolutionReverb& owner;
+    };
+
+    void runHeadStep (Impulse&) noexcept;
+    bool runTailBlock();                    // worker; false if there was nothing to do
+    std::unique_ptr<Impulse> build (const juce::AudioBuffer<float>& ir) const;
+
+    Worker worker { *this };
+
+    Impulse* live = nullptr;                          // audio thread
+    std::atomic<Impulse*> pending { nullptr };        // message → audio
+    std::atomic<Impulse*> retired { nullptr };        // audio → message
+    std::atomic<Impulse*> current { nullptr };        // what the worker should run
+    std::atomic<Impulse*> workerBusy { nullptr };     // hazard pointer
+
+    juce::File irFile;
+    double fs = 44100.0, builtRate = 0.0;
+    float  wetGain = 0.33f * wetScale;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (ConvolutionReverb)
+};
@@ -2,84 +2,471 @@
 #include <cmath>
 
 //----------------------------------------------------------------------
-// prepare
-void DelayLine::prepare (double sampleRate, int maximumDelaySamples)
+// Multi-Tap head layouts (DELAY_TAPS). Ratios are fractions of the delay
+// time, so the longest head is the delay time itself and every pattern
+// fits in the same ring. Later heads are quieter and darker.
+//                                ratio    gain   pan    lpAlpha
+const DelayLine::TapPattern DelayLine::tapPatterns[numTapPatterns] =
+{
+    { 4, { { 0.25f,   1.00f, -0.6f, 0.60f }, { 0.50f,   0.80f,  0.6f, 0.50f },
+           { 0.75f,   0.65f, -0.3f, 0.40f }, { 1.00f,   0.50f,  0.3f, 0.30f } } },          // Quarters
+
+    { 3, { { 0.375f,  0.90f, -0.5f, 0.55f }, { 0.75f,   0.70f,  0.5f, 0.40f },
+           { 1.00f,   0.50f,  0.0f, 0.30f } } },                                            // Dotted
+
+    { 6, { { 1/6.f,   1.00f, -0.7f, 0.65f }, { 2/6.f,   0.85f,  0.7f, 0.55f },
+           { 3/6.f,   0.70f, -0.4f, 0.45f }, { 4/6.f,   0.60f,  0.4f, 0.40f },
+           { 5/6.f,   0.50f, -0.2f, 0.35f }, { 1.00f,   0.40f,  0.2f, 0.30f } } },          // Triplets
+
+    { 5, { { 0.146f,  0.90f,  0.4f, 0.60f }, { 0.236f,  0.80f, -0.4f, 0.50f },
+           { 0.382f,  0.70f,  0.7f, 0.45f }, { 0.618f,  0.60f, -0.7f, 0.35f },
+           { 1.00f,   0.50f,  0.0f, 0.25f } } },                                            // Golden
+
+    { 8, { { 0.125f,  0.95f, -0.1f, 0.70f }, { 0.25f,   0.85f,  0.2f, 0.62f },
+           { 0.375f,  0.78f, -0.3f, 0.55f }, { 0.50f,   0.70f,  0.4f, 0.48f },
+           { 0.625f,  0.62f, -0.5f, 0.42f }, { 0.75f,   0.55f,  0.6f, 0.36f },
+           { 0.875f,  0.48f, -0.7f, 0.30f }, { 1.00f,   0.40f,  0.8f, 0.25f } } },          // Cascade
+};
+
+//----------------------------------------------------------------------
+// prepare (audio stopped)
+DelayLine::~DelayLine()
+{
+    delete pending.exchange (nullptr);
+    delete retired.exchange (nullptr);
+}
+
+void DelayLine::prepare (double sampleRate, int maximumDelaySamples, bool allocateNow)
 {
     fs = sampleRate;
-    buffer.setSize (1, maximumDelaySamples);
-    buffer.clear();
-    bufferSize = buffer.getNumSamples();
+    maxDelaySamples = maximumDelaySamples;
+
+    // Tape / BBD read up to ~1 ms past the delay time
+    const int headroom = (int) std::ceil (0.001 * sampleRate) + guard;
+    ringSize = juce::nextPowerOfTwo (juce::jmax (4, maximumDelaySamples + headroom));
+    mask     = ringSize - 1;
+    maxReadSamples = (float) (ringSize - 2);
+
+    // Nothing runs concurrently here, so stale blocks can go directly
+    delete retired.exchange (nullptr);
+    if (auto* p = pending.load(); p != nullptr && p->ringSize != ringSize)
+        delete pending.exchange (nullptr);
+    if (live != nullptr && live->ringSize != ringSize)
+    {
+        live.reset();
+        ringL = ringR = nullptr;
+    }
+
+    if (allocateNow && live == nullptr)
+    {
+        memoryWanted = false;
+        auto* m = pending.exchange (nullptr);
+        live.reset (m != nullptr ? m : new Memory (ringSize));
+    }
+
+    if (live != nullptr)
+    {
+        juce::FloatVectorOperations::clear (live->data.get(), 2 * (ringSize + guard));
+        adopt (live.release());        // resets the write head and filter state
+    }
+
+    if (pattern == nullptr)
+        pattern = &tapPatterns[0];
+    setType (type);                      // rotators depend on the sample rate
+}
+
+//----------------------------------------------------------------------
+// lazily allocated memory
+bool DelayLine::acquireMemory() noexcept
+{
+    if (live != nullptr)
+        return true;
+
+    // Only this thread empties `pending`, so load-then-exchange is safe.
+    // Clearing the request first means serviceMemory() can never see an
+    // empty slot together with a stale request.
+    if (pending.load() != nullptr)
+    {
+        memoryWanted = false;
+        adopt (pending.exchange (nullptr));
+        return true;
+    }
+
+    memoryWanted = true;
+    return false;
+}
+
+void DelayLine::releaseMemory() noexcept
+{
+    memoryWanted = false;
+    if (retired.load() != nullptr)
+        return;                                   // previous block not freed yet
+
+    if (live == nullptr)
+    {
+        if (pending.load() == nullptr)
+            return;
+        live.reset (pending.exchange (nullptr));  // built but never used
+    }
+
+    ringL = ringR = nullptr;
+    retired = live.release();
+}
+
+void DelayLine::serviceMemory()
+{
+    delete retired.exchange (nullptr);
+
+    if (pending.load() == nullptr && memoryWanted.load())
+        pending = new Memory (ringSize);
+}
+
+void DelayLine::reset() noexcept
+{
+    if (live == nullptr)
+        return;
+
+    juce::FloatVectorOperations::clear (live->data.get(), 2 * (ringSize + guard));
+    adopt (live.release());
+}
+
+double DelayLine::getTailSeconds() const noexcept
+{
+    const double seconds = targetDelayTimeSamples / fs;
+    if (feedback <= 0.001f)
+        return seconds;
+
+    // every repeat is `feedback` quieter; the loop filters only shorten this
+    return seconds * (1.0 - 3.0 / std::log10 ((double) feedback));
+}
+
+void DelayLine::adopt (Memory* m) noexcept
+{
+    jassert (m != nullptr && m->ringSize == ringSize);
+    live.reset (m);
+    ringL = m->data.get();
+    ringR = ringL + ringSize + guard;                     // fresh blocks are zeroed
+
     writePosition = 0;
-    smoothedDelayTimeSamples = 0.0f;
-    previousLowPass = 0.f;
+    smoothedDelayTimeSamples = targetDelayTimeSamples;   // no glide from zero
+    lowPassL = lowPassR = 0.f;
+    tapLp.fill (0.f);
 }
 
 //----------------------------------------------------------------------
 // parameter setters (delayTime clamped inside)
 void DelayLine::setDelayTime (float seconds)
 {
-    float maxDelaySecs = static_cast<float> (bufferSize - 3) / static_cast<float> (fs);
+    float maxDelaySecs = static_cast<float> (maxDelaySamples) / static_cast<float> (fs);
     seconds = juce::jlimit (0.f, maxDelaySecs, seconds);
-    targetDelayTimeSamples = seconds * static_cast<float> (fs);
+
+    // Whole samples: a settled delay can then use the integer tap
+    targetDelayTimeSamples = std::round (seconds * static_cast<float> (fs));
+}
+
+void DelayLine::setType (DelayType newType) noexcept
+{
+    type = newType;
+
+    //                       lpAlpha  wowHz wowMs  flutHz flutMs drive
+    static constexpr Flavour tape { 0.22f, 0.5f, 0.5f,  6.5f, 0.05f, 1.6f };
+    static constexpr Flavour bbd  { 0.12f, 0.3f, 0.8f,  0.0f, 0.0f,  2.5f };
+    flavour = (type == DelayType::BBD) ? bbd : tape;
+
+    setRotator (flavour.wowHz,     wowRotC, wowRotS);
+    setRotator (flavour.flutterHz, fltRotC, fltRotS);
+}
+
+void DelayLine::setTapPattern (int patternIndex) noexcept
+{
+    pattern = &tapPatterns[juce::jlimit (0, numTapPatterns - 1, patternIndex)];
+}
+
+void DelayLine::setRotator (float hz, float& rotC, float& rotS) const noexcept
+{
+    const double w = juce::MathConstants<double>::twoPi * hz / fs;
+    rotC = (float) std::cos (w);
+    rotS = (float) std::sin (w);
 }
 
 //----------------------------------------------------------------------
-// process mono block – DIGITAL flavour only
-void DelayLine::processBlock (juce::AudioBuffer<float>& buf, DelayType)
+// process
+void DelayLine::processBlock (juce::AudioBuffer<float>& buf)
+{
+    process (buf.getWritePointer (0),
+             buf.getNumChannels() > 1 ? buf.getWritePointer (1) : nullptr,
+             buf.getNumSamples());
+}
+
+void DelayLine::process (float* left, float* right, int numSamples) noexcept
+{
+    // Tape / BBD read at a moving position every sample anyway
+    if (type == DelayType::Tape || type == DelayType::BBD)
+    {
+        if (right != nullptr) runModulated<true>  (left, right, numSamples);
+        else                  runModulated<false> (left, right, numSamples);
+        return;
+    }
+
+    const bool multi = (type == DelayType::MultiTap);
+
+    // Delay time still moving: smoothed fractional reads
+    const int i = samplesUntilSettled (numSamples);
+    if (i > 0)
+    {
+        if (multi) { if (right != nullptr) runMultiTap<true, true>  (left, right, 0, i);
+                     else                  runMultiTap<true, false> (left, right, 0, i); }
+        else       { if (right != nullptr) run<true, true>  (left, right, 0, i);
+                     else                  run<true, false> (left, right, 0, i); }
+    }
+
+    if (i == numSamples)
+        return;
+    smoothedDelayTimeSamples = targetDelayTimeSamples;   // settled → integer tap
+
+    // Settled: integer tap, no interpolation
+    if (multi) { if (right != nullptr) runMultiTap<false, true>  (left, right, i, numSamples);
+                 else                  runMultiTap<false, false> (left, right, i, numSamples); }
+    else       { if (right != nullptr) run<false, true>  (left, right, i, numSamples);
+                 else                  run<false, false> (left, right, i, numSamples); }
+}
+
+int DelayLine::samplesUntilSettled (int numSamples) const noexcept
+{
+    constexpr float smooth = 0.01f;
+
+    if (smoothedDelayTimeSamples == targetDelayTimeSamples)
+        return 0;
+
+    // samples until the one-pole is within 1e-3 of the target
+    const float dist  = std::abs (targetDelayTimeSamples - smoothedDelayTimeSamples);
+    const int   steps = (int) std::ceil (std::log (1.0e-3f / dist) / std::log (1.f - smooth));
+    return juce::jlimit (0, numSamples, steps);
+}
+
+//----------------------------------------------------------------------
+// DIGITAL
+template <bool interpolate, bool stereo>
+void DelayLine::run (float* left, float* right, int start, int end) noexcept
+{
+    constexpr float smooth  = 0.01f;
+    constexpr float alphaLP = 0.35f;   // very simple LP "digital" tone-shaping
+
+    const int   tap   = (int) targetDelayTimeSamples;
+    const float dry   = 1.f - mix;
+    const float fbOwn = feedback * (pingPong ? 0.f : 1.f - cross);
+    const float fbX   = feedback * (pingPong ? 1.f : cross);
+
+    float lpL = lowPassL, lpR = lowPassR;
+
+    for (int i = start; i < end; ++i)
+    {
+        float wetL, wetR = 0.f;
+        if constexpr (interpolate)
+        {
+            smoothedDelayTimeSamples = (1.f - smooth)*smoothedDelayTimeSamples
+                                     + smooth * targetDelayTimeSamples;
+            wetL = readCubic (ringL, smoothedDelayTimeSamples);
+            if constexpr (stereo) wetR = readCubic (ringR, smoothedDelayTimeSamples);
+        }
+        else
+        {
+            const int r = (writePosition - tap) & mask;
+            wetL = ringL[r];
+            if constexpr (stereo) wetR = ringR[r];
+        }
+
+        lpL = alphaLP * wetL + (1.f - alphaLP) * lpL;
+        const float inL = left[i];
+
+        if constexpr (stereo)
+        {
+            lpR = alphaLP * wetR + (1.f - alphaLP) * lpR;
+            const float inR = right[i];
+
+            left[i]  = inL * dry + lpL * mix;
+            right[i] = inR * dry + lpR * mix;
+
+            const float sendL = pingPong ? 0.5f * (inL + inR) : inL;
+            const float sendR = pingPong ? 0.f                : inR;
+            write (ringL, juce::jlimit (-1.5f, 1.5f, sendL + lpL * fbOwn + lpR * fbX));
+            write (ringR, juce::jlimit (-1.5f, 1.5f, sendR + lpR * fbOwn + lpL * fbX));
+        }
+        else
+        {
+            left[i] = inL * dry + lpL * mix;
+            write (ringL, juce::jlimit (-1.5f, 1.5f, inL + lpL * feedback));
+        }
+
+        writePosition = (writePosition + 1) & mask;
+    }
+
+    lowPassL = lpL;
+    lowPassR = lpR;
+}
+
+//----------------------------------------------------------------------
+// TAPE / BBD – wow and flutter move the read head, the record path saturates
+template <bool stereo>
+void DelayLine::runModulated (float* left, float* right, int numSamples) noexcept
 {
-    const int numSamples = buf.getNumSamples();
     constexpr float smooth = 0.01f;
+
+    const float dry   = 1.f - mix;
+    const float fbOwn = feedback * (pingPong ? 0.f : 1.f - cross);
+    const float fbX   = feedback * (pingPong ? 1.f : cross);
+    const float a     = flavour.lpAlpha;
+    const float drive = flavour.drive, invDrive = 1.f / drive;
+
+    const float msToSamples = (float) fs * 0.001f;
+    const float wowDepth = flavour.wowMs     * msToSamples;
+    const float fltDepth = flavour.flutterMs * msToSamples;
+
+    float lpL = lowPassL, lpR = lowPassR;
+    float wc = wowC, ws = wowS, fc = fltC, fls = fltS;
+
     for (int i = 0; i < numSamples; ++i)
     {
-        smoothedDelayTimeSamples = (1.f - smooth)*smoothedDelayTimeSamples
-                                 + smooth * targetDelayTimeSamples;
+        smoothedDelayTimeSamples += smooth * (targetDelayTimeSamples - smoothedDelayTimeSamples);
+
+        // read position = smoothed time + wow + flutter (sines from the rotators)
+        const float d = juce::jlimit (3.f, maxReadSamples,
+                                      smoothedDelayTimeSamples + wowDepth * ws + fltDepth * fls);
+        const float w1 = wc * wowRotC - ws * wowRotS;  ws = ws * wowRotC + wc * wowRotS;  wc = w1;
+        const float f1 = fc * fltRotC - fls * fltRotS; fls = fls * fltRotC + fc * fltRotS; fc = f1;
+
+        lpL += a * (readCubic (ringL, d) - lpL);
+        const float inL = left[i];
+
+        if constexpr (stereo)
+        {
+            lpR += a * (readCubic (ringR, d) - lpR);
+            const float inR = right[i];
+
+            left[i]  = inL * dry + lpL * mix;
+            right[i] = inR * dry + lpR * mix;
+
+            const float sendL = pingPong ? 0.5f * (inL + inR) : inL;
+            const float sendR = pingPong ? 0.f                : inR;
+            write (ringL, saturate (drive * (sendL + lpL * fbOwn + lpR * fbX)) * invDrive);
+            write (ringR, saturate (drive * (sendR + lpR * fbOwn + lpL * fbX)) * invDrive);
+        }
+        else
+        {
+            left[i] = inL * dry + lpL * mix;
+            write (ringL, saturate (drive * (inL + lpL * feedback)) * invDrive);
+        }
+
+        writePosition = (writePosition + 1) & mask;
+    }
+
+    // keep the rotators on the unit circle (float error grows slowly)
+    const float gw = 1.5f - 0.5f * (wc * wc + ws * ws);
+    const float gf = 1.5f - 0.5f * (fc * fc + fls * fls);
+    wowC = wc * gw;  wowS = ws * gw;
+    fltC = fc * gf;  fltS = fls * gf;
+
+    lowPassL = lpL;
+    lowPassR = lpR;
+}
+
+//----------------------------------------------------------------------
+// MULTI-TAP – all heads read the left ring; the longest head feeds back
+template <bool interpolate, bool stereo>
+void DelayLine::runMultiTap (float* left, float* right, int start, int end) noexcept
+{
+    constexpr float smooth = 0.01f;
+
+    const int   numTaps = pattern->numTaps;
+    const float dry     = 1.f - mix;
+
+    // per-block head constants; the sum is normalised to unit power so the
+    // wet level does not jump with the number of heads
+    float power = 0.f;
+    for (int t = 0; t < numTaps; ++t)
+        power += pattern->taps[t].gain * pattern->taps[t].gain;
+    const float norm = 1.f / std::sqrt (power);
+
+    float ratio[maxTaps], gainL[maxTaps], gainR[maxTaps], alpha[maxTaps];
+    int   tapPos[maxTaps];
+    for (int t = 0; t < numTaps; ++t)
+    {
+        const auto& h = pattern->taps[t];
+        ratio[t]  = h.ratio;
+        alpha[t]  = h.lpAlpha;
+        gainL[t]  = norm * h.gain * (stereo ? juce::jmin (1.f, 1.f - h.pan) : 1.f);
+        gainR[t]  = norm * h.gain * juce::jmin (1.f, 1.f + h.pan);
+        tapPos[t] = juce::jmax (1, (int) std::round (targetDelayTimeSamples * h.ratio));
+    }
 
-        float readPos = float(writePosition) - smoothedDelayTimeSamples;
-        if (readPos < 0) readPos += bufferSize;
+    float lp[maxTaps];
+    std::copy (tapLp.begin(), tapLp.begin() + numTaps, lp);
 
-        float delayedSample = getCubicInterpolatedSample (readPos);
+    for (int i = start; i < end; ++i)
+    {
+        if constexpr (interpolate)
+            smoothedDelayTimeSamples = (1.f - smooth)*smoothedDelayTimeSamples
+                                     + smooth * targetDelayTimeSamples;
 
-        // very simple LP "digital" tone-shaping
-        const float alphaLP  = 0.35f;
-        delayedSample = alphaLP * delayedSample + (1.f - alphaLP) * previousLowPass;
-        previousLowPass = delayedSample;
+        float wetL = 0.f, wetR = 0.f;
+        for (int t = 0; t < numTaps; ++t)
+        {
+            float x;
+            if constexpr (interpolate) x = readCubic (ringL, juce::jmax (3.f, smoothedDelayTimeSamples * ratio[t]));
+            else                       x = ringL[(writePosition - tapPos[t]) & mask];
 
-        float in  = buf.getSample (0, i);
-        float wet = delayedSample;
+            lp[t] += alpha[t] * (x - lp[t]);
+            wetL  += gainL[t] * lp[t];
+            if constexpr (stereo) wetR += gainR[t] * lp[t];
+        }
 
-        float out = in * (1.f - mix) + wet * mix;
-        buf.setSample (0, i, out);
+        const float inL = left[i];
+        left[i] = inL * dry + wetL * mix;
 
-        float feedbackSample = juce::jlimit (-1.5f, 1.5f, in + wet * feedback);
-        buffer.setSample (0, writePosition, feedbackSample);
+        float send = inL;
+        if constexpr (stereo)
+        {
+            const float inR = right[i];
+            right[i] = inR * dry + wetR * mix;
+            send = 0.5f * (inL + inR);
+        }
 
-        if (++writePosition >= bufferSize) writePosition = 0;
+        write (ringL, juce::jlimit (-1.5f, 1.5f, send + lp[numTaps - 1] * feedback));
+        writePosition = (writePosition + 1) & mask;
     }
+
+    std::copy (lp, lp + numTaps, tapLp.begin());
 }
 
 //----------------------------------------------------------------------
 // helpers --------------------------------------------------------------
-float DelayLine::getBufferSample (int index)
+inline void DelayLine::write (float* ring, float x) const noexcept
 {
-    index %= bufferSize;
-    if (index < 0) index += bufferSize;
-    return buffer.getSample (0, index);
+    ring[writePosition] = x;
+    if (writePosition < guard)
+        ring[ringSize + writePosition] = x;   // mirror for contiguous reads
 }
 
-float DelayLine::getCubicInterpolatedSample (float readPos)
+inline float DelayLine::saturate (float x) noexcept
 {
-    int idx = (int) std::floor (readPos);
-    float frac = readPos - idx;
+    // rational tanh approximation, exact slope 1 at 0 and ±1 at |x| = 3
+    x = juce::jlimit (-3.f, 3.f, x);
+    return x * (27.f + x * x) / (27.f + 9.f * x * x);
+}
+
+float DelayLine::readCubic (const float* ring, float delaySamples) const noexcept
+{
+    const float readPos = float (writePosition) - delaySamples;
+    const float fl      = std::floor (readPos);
+    const float frac    = readPos - fl;
 
-    float s0 = getBufferSample (idx - 1);
-    float s1 = getBufferSample (idx);
-    float s2 = getBufferSample (idx + 1);
-    float s3 = getBufferSample (idx + 2);
+    // s0 … s3 = samples idx-1 … idx+2, contiguous thanks to the guard
+    const float* s = ring + (((int) fl - 1) & mask);
 
-    float a = -0.5f*s0 + 1.5f*s1 - 1.5f*s2 + 0.5f*s3;
-    float b =  s0     - 2.5f*s1 + 2.0f*s2 - 0.5f*s3;
-    float c = -0.5f*s0           + 0.5f*s2;
-    float d =  s1;
+    float a = -0.5f*s[0] + 1.5f*s[1] - 1.5f*s[2] + 0.5f*s[3];
+    float b =  s[0]     - 2.5f*s[1] + 2.0f*s[2] - 0.5f*s[3];
+    float c = -0.5f*s[0]            + 0.5f*s[2];
+    float d =  s[1];
 
     return ((a*frac + b)*frac + c)*frac + d;
-} 
\ No newline at end of file
+}
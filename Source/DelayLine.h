@@ -1,42 +1,162 @@
 #pragma once
 #include <JuceHeader.h>
+#include <array>
+#include <atomic>
+#include <memory>
 
+//==============================================================================
+// Stereo feedback delay on two power-of-two ring buffers, processed in place
+// on the host's channels in one pass.
+//
+// Indices wrap with a mask. The first `guard` samples of each ring are
+// mirrored past its end, so the cubic interpolator always reads four
+// contiguous samples without wrapping. Once the smoothed delay time has
+// settled it snaps to a whole number of samples and the block runs an
+// integer-tap loop with no interpolation at all.
+//
+// Memory is not taken in prepare(). The rings are sized for the longest
+// reachable delay time and allocated lazily: the audio thread asks for them
+// in acquireMemory(), serviceMemory() (message thread) builds the block and
+// hands it over through an atomic slot, and releaseMemory() hands it back
+// after a long bypass. The audio thread never allocates or frees.
+//
+// Types (DELAY_TYPE):
+//   Digital   – clean repeats through a gentle one-pole LP
+//   Tape      – wow + flutter modulated read, darker LP, saturated feedback
+//   BBD       – slow chorus-like modulation, dark LP, harder saturation
+//   Multi-Tap – up to 8 read heads on the left ring (fed (L+R)/2), each with
+//               its own time, gain, pan and LP; the longest head feeds back
+//
+// Feedback routing (Digital / Tape / BBD):
+//   normal     – each side feeds back (1 - cross) of itself + cross of the other
+//   ping-pong  – (L+R)/2 enters the left ring only and the echoes alternate
+//                sides (full cross-feedback)
+//==============================================================================
 class DelayLine
 {
 public:
-    enum class DelayType { Digital };
+    enum class DelayType { Digital = 0, Tape, BBD, MultiTap };
+
+    static constexpr int maxTaps = 8;
+    static constexpr int numTapPatterns = 5;   // Quarters, Dotted, Triplets, Golden, Cascade
 
     DelayLine() = default;
+    ~DelayLine();
+
+    /** Sizes the rings for delay times up to maximumDelaySamples. Drops any
+        memory of the wrong size; allocates at once only if allocateNow. */
+    void prepare (double sampleRate, int maximumDelaySamples, bool allocateNow);
+
+    /** Audio thread: true once the rings exist, otherwise requests them. */
+    bool acquireMemory() noexcept;
+    /** Audio thread: hand the rings back to be freed (long bypass). */
+    void releaseMemory() noexcept;
+    /** Message thread: build a requested block, free a released one. */
+    void serviceMemory();
+    bool hasMemory() const noexcept { return live != nullptr; }
+
+    /** Audio thread: silence the rings and loop filters (no-op without memory). */
+    void reset() noexcept;
+
+    /** Seconds for the echoes to fall by 60 dB at the current time and feedback. */
+    double getTailSeconds() const noexcept;
 
-    void prepare (double sampleRate, int maximumDelaySamples);
-    void processBlock (juce::AudioBuffer<float>&, DelayType type = DelayType::Digital);
+    /** In place on channels 0/1 (a mono buffer runs the left ring only). */
+    void processBlock (juce::AudioBuffer<float>&);
+
+    /** In place on two contiguous channels; right may be nullptr for mono. */
+    void process (float* left, float* right, int numSamples) noexcept;
+
+    void setType (DelayType newType) noexcept;
+    /** Multi-Tap head layout, index into the DELAY_TAPS pattern list. */
+    void setTapPattern (int patternIndex) noexcept;
 
     void setDelayTime (float seconds);
     void setFeedback  (float fb)   { feedback = juce::jlimit (0.f, 0.98f, fb); }
     void setMix       (float m)    { mix      = juce::jlimit (0.f, 1.f,  m ); }
+    void setCrossFeedback (float c) { cross   = juce::jlimit (0.f, 1.f,  c ); }
+    void setPingPong  (bool on)    { pingPong = on; }
 
 private:
+    static constexpr int guard = 3;   // mirrored samples for the 4-point read
+
+    // Both rings in one zeroed block, owned by whichever thread holds it
+    struct Memory
+    {
+        explicit Memory (int size) : ringSize (size) { data.calloc ((size_t) 2 * (size_t) (size + guard)); }
+        juce::HeapBlock<float> data;
+        int ringSize;
+    };
+
+    void adopt (Memory*) noexcept;
+
+    // One Multi-Tap head: time as a fraction of the delay time, gain, pan, LP
+    struct Tap { float ratio, gain, pan, lpAlpha; };
+    struct TapPattern { int numTaps; Tap taps[maxTaps]; };
+    static const TapPattern tapPatterns[numTapPatterns];
+
+    // Character of the Tape / BBD modes
+    struct Flavour
+    {
+        float lpAlpha;                   // one-pole LP in the loop (lower = darker)
+        float wowHz, wowMs;              // slow pitch wander
+        float flutterHz, flutterMs;      // fast pitch wobble
+        float drive;                     // feedback saturation drive
+    };
+
     // ----------------------------------------------------------------
-    float getCubicInterpolatedSample (float readPos);
-    float getBufferSample (int index);
+    int  samplesUntilSettled (int numSamples) const noexcept;
+
+    template <bool interpolate, bool stereo>
+    void run (float* left, float* right, int start, int end) noexcept;
+    template <bool stereo>
+    void runModulated (float* left, float* right, int numSamples) noexcept;
+    template <bool interpolate, bool stereo>
+    void runMultiTap (float* left, float* right, int start, int end) noexcept;
+
+    void  setRotator (float hz, float& rotC, float& rotS) const noexcept;
+    float readCubic (const float* ring, float delaySamples) const noexcept;
+    void  write (float* ring, float x) const noexcept;
+    static float saturate (float x) noexcept;
 
     // --- internal state --------------------------------------------
-    juce::AudioBuffer<float> buffer;
-    int     bufferSize          { 0 };
+    std::unique_ptr<Memory> live;                         // audio thread only
+    std::atomic<Memory*>    pending  { nullptr };         // message → audio
+    std::atomic<Memory*>    retired  { nullptr };         // audio → message
+    std::atomic<bool>       memoryWanted { false };
+
+    float*  ringL               { nullptr };   // ringSize + guard samples each, in `live`
+    float*  ringR               { nullptr };
+    int     ringSize            { 0 };
+    int     mask                { 0 };
+    int     maxDelaySamples     { 0 };
+    float   maxReadSamples      { 0.f };       // longest time + modulation headroom
     int     writePosition       { 0 };
     double  fs                  { 44100.0 };
 
-    // smoothed delay‑time
+    // smoothed delay‑time (target is whole samples, see setDelayTime)
     float   targetDelayTimeSamples   { 0.f };
     float   smoothedDelayTimeSamples { 0.f };
 
-    // cheap 1‑pole LP for digital flavour
-    float previousLowPass { 0.f };
+    // cheap 1‑pole LP for digital flavour, per side
+    float lowPassL { 0.f }, lowPassR { 0.f };
+
+    // Tape / BBD modulation: two quadrature rotators (cos, sin)
+    Flavour flavour {};
+    float wowC { 1.f }, wowS { 0.f }, wowRotC { 1.f }, wowRotS { 0.f };
+    float fltC { 1.f }, fltS { 0.f }, fltRotC { 1.f }, fltRotS { 0.f };
+
+    // Multi-Tap per-head filter state
+    const TapPattern* pattern { nullptr };
+    std::array<float, maxTaps> tapLp {};
 
     // user parameters
+    DelayType type { DelayType::Digital };
     float feedback { 0.5f };
     float mix      { 0.3f };
+    float cross    { 0.0f };
+    bool  pingPong { false };
 
     // helper
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (DelayLine)
-}; 
\ No newline at end of file
+};
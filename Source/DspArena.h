@@ -0,0 +1,81 @@
+#pragma once
+#include <JuceHeader.h>
+#include <new>
+#include <type_traits>
+
+//==============================================================================
+// One 64-byte aligned block of floats per plugin instance, carved up in
+// prepareToPlay into the voice scratch buffers and the voice bus.
+// Allocation happens once, in allocate(); take() only moves a cursor,
+// so nothing that renders audio ever touches the heap.
+//
+// Usage: sum the consumers' arenaFloats() sizes, allocate() that many, then
+// prepare each consumer with the arena in the same order.
+// Small structs (the voices' hot state) can live here too: create<T>()
+// constructs them in place, as one contiguous array.
+//==============================================================================
+class DspArena
+{
+public:
+    static constexpr size_t alignment = 64;
+    static constexpr size_t floatsPerLine = alignment / sizeof (float);
+
+    /** A request rounded up to whole cache lines, so every region starts aligned. */
+    static constexpr size_t padded (size_t numFloats) noexcept
+    {
+        return (numFloats + floatsPerLine - 1) & ~(floatsPerLine - 1);
+    }
+
+    /** (Re)allocate and zero the block. prepareToPlay only. */
+    void allocate (size_t totalFloats)
+    {
+        totalFloats = padded (totalFloats);
+        if (totalFloats > capacity)
+        {
+            storage.allocate (totalFloats + floatsPerLine, false);
+            const auto addr = reinterpret_cast<uintptr_t> (storage.get());
+            base     = reinterpret_cast<float*> ((addr + alignment - 1) & ~(uintptr_t) (alignment - 1));
+            capacity = totalFloats;
+        }
+        juce::FloatVectorOperations::clear (base, (int) capacity);
+        used = 0;
+    }
+
+    /** Next aligned, zeroed region of numFloats. Never allocates. */
+    float* take (size_t numFloats) noexcept
+    {
+        numFloats = padded (numFloats);
+        jassert (used + numFloats <= capacity);   // a consumer's arenaFloats() is out of date
+        auto* p = base + used;
+        used += numFloats;
+        return p;
+    }
+
+    /** Floats an array of count T occupies, whole cache lines. */
+    template <typename T>
+    static constexpr size_t floatsFor (size_t count) noexcept
+    {
+        return padded ((sizeof (T) * count + sizeof (float) - 1) / sizeof (float));
+    }
+
+    /** count default-constructed T, back to back. Never allocates. */
+    template <typename T>
+    T* create (size_t count) noexcept
+    {
+        static_assert (alignof (T) <= alignment, "arena regions are only cache-line aligned");
+        static_assert (std::is_trivially_destructible<T>::value, "the arena never runs destructors");
+
+        auto* p = reinterpret_cast<T*> (take (floatsFor<T> (count)));
+        for (size_t i = 0; i < count; ++i)
+            new (p + i) T();
+        return p;
+    }
+
+    size_t getCapacity() const noexcept { return capacity; }
+    size_t getUsed() const noexcept     { return used; }
+
+private:
+    juce::HeapBlock<float> storage;
+    float* base     = nullptr;
+    size_t capacity = 0, used = 0;
+};
@@ -0,0 +1,398 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+#include <memory>
+
+//==============================================================================
+// Feedback-delay-network reverb, the REVERB_ALGO = FDN engine.
+//
+// 8 or 16 delay lines whose outputs are damped, mixed by a normalised
+// Hadamard matrix and fed back. The matrix is applied as a fast
+// Walsh–Hadamard transform: log2 N add/subtract butterflies and one scale.
+// The stages with a stride of at least one SIMD register run on whole
+// registers; the in-register ones (and the tap gathers) stay scalar. The
+// per-line decay and damping run on registers as well.
+//
+// Each line is read through a slowly modulated linear tap (one shared sine,
+// a different phase per line) and decays in two bands: a one-pole split at
+// the crossover with separate RT60s below and above it. Even lines take the
+// left input and feed the left output, odd lines the right.
+//
+// The rings (16 × ~321 ms, rounded up to a power of two at the tank's own
+// rate) are not taken in prepare(). As in DelayLine, the audio thread asks
+// for them in acquireMemory(), serviceMemory() (message thread) builds the
+// block and hands it over through an atomic slot, and releaseMemory() hands
+// it back once the FDN is no longer selected.
+//==============================================================================
+class FdnReverb
+{
+public:
+    static constexpr int   maxLines     = 16;
+    static constexpr float maxSizeScale = 2.0f;    // REVERB_SIZE max
+    static constexpr float longestMs    = 160.0f;  // longest line in any preset
+    static constexpr float maxModMs     = 1.0f;
+
+    struct Settings
+    {
+        int   numLines    = 16;       // 8 or 16
+        float minMs       = 25.f;     // shortest / longest line, before size scaling
+        float maxMs       = 100.f;
+        float rt60Low     = 2.0f;     // seconds, below the crossover
+        float rt60High    = 1.0f;     // seconds, above it
+        float crossoverHz = 4000.f;
+        float modMs       = 0.2f;     // read-tap modulation depth
+        float modHz       = 0.5f;
+    };
+
+    /** The REVERB_TYPE list mapped onto the FDN; size scales lengths and decay. */
+    static Settings presetFor (int reverbType, float sizeScale) noexcept
+    {
+        //                     lines minMs maxMs  rtLow rtHigh xover  modMs modHz
+        static constexpr Settings table[] =
+        {
+            {  8,  25.f,  75.f, 1.8f, 1.0f, 4000.f, 0.20f, 0.50f },   // Classic
+            { 16,  40.f, 140.f, 3.5f, 2.0f, 3500.f, 0.35f, 0.40f },   // Hall
+            { 16,  12.f,  60.f, 2.2f, 1.8f, 8000.f, 0.15f, 0.80f },   // Plate
+            { 16,  45.f, 150.f, 6.0f, 5.0f, 9000.f, 0.60f, 0.30f },   // Shimmer
+            {  8,  18.f,  55.f, 1.6f, 0.7f, 2500.f, 0.80f, 1.20f },   // Spring
+            {  8,  10.f,  40.f, 0.8f, 0.5f, 5000.f, 0.10f, 0.60f },   // Room
+            { 16,  60.f, 160.f, 7.0f, 3.5f, 3000.f, 0.40f, 0.25f },   // Cathedral
+            { 16,   8.f,  35.f, 0.35f,0.3f, 6000.f, 0.10f, 0.70f },   // Gated
+        };
+
+        auto s = table[juce::jlimit (0, (int) std::size (table) - 1, reverbType)];
+        sizeScale = juce::jlimit (0.1f, maxSizeScale, sizeScale);
+        s.minMs   *= sizeScale;   s.maxMs    *= sizeScale;
+        s.rt60Low *= sizeScale;   s.rt60High *= sizeScale;
+        return s;
+    }
+
+    FdnReverb() = default;
+    ~FdnReverb()
+    {
+        delete pending.exchange (nullptr);
+        delete retired.exchange (nullptr);
+    }
+
+    /** Sizes the rings for sampleRate. Drops memory of the wrong size;
+        allocates at once only if allocateNow. */
+    void prepare (double sampleRate, bool allocateNow)
+    {
+        fs = sampleRate;
+        const int longest = (int) std::ceil ((longestMs * maxSizeScale + maxModMs) * 0.001 * sampleRate) + 4;
+        ringSize = juce::nextPowerOfTwo (longest);
+        mask     = ringSize - 1;
+
+        // Nothing runs concurrently here, so stale blocks can go directly
+        delete retired.exchange (nullptr);
+        if (auto* p = pending.load(); p != nullptr && p->ringSize != ringSize)
+            delete pending.exchange (nullptr);
+        if (live != nullptr && live->ringSize != ringSize)
+            live.reset();
+
+        if (allocateNow)
+            allocateNowIfMissing();
+
+        setSettings (settings);
+        reset();
+    }
+
+    /** Message thread, nothing rendering: build the rings right away (an
+        offline render can't wait for serviceMemory()). */
+    void allocateNowIfMissing()
+    {
+        if (live != nullptr)
+            return;
+        memoryWanted = false;
+        auto* m = pending.exchange (nullptr);
+        live.reset (m != nullptr ? m : new Memory (ringSize));
+        reset();
+    }
+
+    /** Audio thread: true once the rings exist, otherwise requests them. */
+    bool acquireMemory() noexcept
+    {
+        if (live != nullptr)
+            return true;
+
+        // only this thread empties `pending`; clear the request first so
+        // serviceMemory() never sees an empty slot with a stale request
+        if (pending.load() != nullptr)
+        {
+            memoryWanted = false;
+            live.reset (pending.exchange (nullptr));
+            reset();
+            return true;
+        }
+
+        memoryWanted = true;
+        return false;
+    }
+
+    /** Audio thread: hand the rings back to be freed. */
+    void releaseMemory() noexcept
+    {
+        memoryWanted = false;
+        if (live == nullptr || retired.load() != nullptr)
+            return;                                   // nothing held, or previous block not freed yet
+        retired = live.release();
+    }
+
+    /** Message thread: build a requested block, free a released one. */
+    void serviceMemory()
+    {
+        delete retired.exchange (nullptr);
+        if (pending.load() == nullptr && memoryWanted.load())
+            pending = new Memory (ringSize);
+    }
+
+    bool hasMemory() const noexcept { return live != nullptr; }
+
+    void reset() noexcept
+    {
+        if (live != nullptr)
+            juce::FloatVectorOperations::clear (live->data.get(), maxLines * ringSize);
+        for (auto& v : lp) v = Vec::expand (0.0f);
+        pos = 0;
+        lfoC = 1.0f; lfoS = 0.0f;
+    }
+
+    /** Eco quality caps the tank at 8 lines. */
+    void setMaxLines (int n) noexcept
+    {
+        maxLinesAllowed = n;
+        setSettings (settings);
+    }
+
+    /** Same meaning as juce::Reverb::Parameters' levels, so presets match.
+        Wet only: ReverbProcessor adds the dry part at the session rate. */
+    void setLevels (float wetLevel, float width) noexcept
+    {
+        wetGain = wetLevel * wetScale;
+        wetWidth = width;
+    }
+
+    /** Recomputes lengths, decay and modulation. Cheap; audio thread is fine. */
+    void setSettings (const Settings& s) noexcept
+    {
+        settings = s;
+        const int previousLines = numLines;
+        numLines = juce::jmin (s.numLines, maxLinesAllowed) >= 16 ? 16 : 8;
+
+        // lines coming back from 8 → 16 still hold the audio and filter
+        // state they had when they were dropped; start them silent
+        if (numLines > previousLines)
+        {
+            if (live != nullptr)
+                juce::FloatVectorOperations::clear (live->data.get() + previousLines * ringSize,
+                                                    (numLines - previousLines) * ringSize);
+            for (int v = previousLines / lanes; v < numLines / lanes; ++v)
+                lp[v] = Vec::expand (0.0f);
+        }
+
+        const float lpA = 1.0f - std::exp (-juce::MathConstants<float>::twoPi * s.crossoverHz / (float) fs);
+        depth = juce::jmin (s.modMs, maxModMs) * 0.001f * (float) fs;
+        const float rot = juce::MathConstants<float>::twoPi * s.modHz / (float) fs;
+        rotC = std::cos (rot);
+        rotS = std::sin (rot);
+
+        alignas (sizeof (Vec)) float gH[maxLines] {}, gD[maxLines] {}, a[maxLines] {};
+        const float maxLen = (float) (ringSize - 3) - depth;
+        for (int k = 0; k < numLines; ++k)
+        {
+            // exponential spread, rounded to primes so no two lines share a mode
+            const float t = (float) k / (float) (numLines - 1);
+            const float ms = s.minMs * std::pow (s.maxMs / s.minMs, t);
+            const int   n  = nextPrime ((int) (ms * 0.001f * (float) fs));
+            len[k] = juce::jlimit (depth + 2.0f, maxLen, (float) n);
+
+            const float gLow  = std::pow (10.0f, -3.0f * len[k] / (s.rt60Low  * (float) fs));
+            const float gHigh = std::pow (10.0f, -3.0f * len[k] / (s.rt60High * (float) fs));
+            gH[k] = gHigh;
+            gD[k] = gLow - gHigh;
+            a[k]  = lpA;
+
+            const float phase = juce::MathConstants<float>::twoPi * (float) k / (float) numLines;
+            phC[k] = std::cos (phase);
+            phS[k] = std::sin (phase);
+        }
+
+        for (int v = 0; v < maxLines / lanes; ++v)
+        {
+            gainHigh[v] = Vec::fromRawArray (gH + v * lanes);
+            gainDiff[v] = Vec::fromRawArray (gD + v * lanes);
+            lpAlpha[v]  = Vec::fromRawArray (a  + v * lanes);
+        }
+    }
+
+    /** Seconds for the tail to fall by 60 dB, including the longest line. */
+    double getDecaySeconds() const noexcept
+    {
+        return juce::jmax (settings.rt60Low, settings.rt60High) + settings.maxMs * 0.001;
+    }
+
+    /** In place, input replaced by the wet signal; right may be nullptr.
+        Silent until acquireMemory() has succeeded. */
+    void process (float* left, float* right, int numSamples) noexcept
+    {
+        if (live == nullptr)
+        {
+            juce::FloatVectorOperations::clear (left, numSamples);
+            if (right != nullptr)
+                juce::FloatVectorOperations::clear (right, numSamples);
+            return;
+        }
+
+        if (numLines == 16) run<16> (left, right, numSamples);
+        else                run<8>  (left, right, numSamples);
+    }
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes = (int) Vec::SIMDNumElements;
+    static_assert (maxLines % lanes == 0 && 8 % lanes == 0, "line count must fill whole registers");
+
+    // Scales the raw tank output to roughly juce::Reverb's wet level
+    static constexpr float wetScale = 0.5f;
+
+    template <int N>
+    void run (float* left, float* right, int numSamples) noexcept
+    {
+        constexpr int   V        = N / lanes;
+        const     float mixNorm  = 1.0f / std::sqrt ((float) N);          // orthonormal Hadamard
+        const     float outNorm  = std::sqrt (2.0f / (float) N);           // N/2 lines per side
+        const     float inNorm   = std::sqrt (2.0f / (float) N);
+
+        alignas (sizeof (Vec)) float x[N], y[N];
+        float* const lines = live->data.get();
+
+        for (int i = 0; i < numSamples; ++i)
+        {
+            const float inL = left[i];
+            const float inR = right != nullptr ? right[i] : inL;
+
+            // shared modulation sine, a different phase per line
+            const float c = lfoC, s = lfoS;
+            lfoC = c * rotC - s * rotS;
+            lfoS = s * rotC + c * rotS;
+
+            // gather the modulated taps
+            float wetL = 0.0f, wetR = 0.0f;
+            for (int k = 0; k < N; ++k)
+            {
+                const float d  = len[k] + depth * (c * phS[k] + s * phC[k]);
+                const int   di = (int) d;
+                const float f  = d - (float) di;
+                const float* line = lines + k * ringSize;
+                const float a0 = line[(pos - di)     & mask];
+                const float a1 = line[(pos - di - 1) & mask];
+                x[k] = a0 + f * (a1 - a0);
+
+                const float signedTap = (k & 2) ? -x[k] : x[k];   // decorrelate the sums
+                if (k & 1) wetR += signedTap; else wetL += signedTap;
+            }
+
+            // two-band decay on whole registers
+            for (int v = 0; v < V; ++v)
+            {
+                const auto xv = Vec::fromRawArray (x + v * lanes);
+                lp[v] += lpAlpha[v] * (xv - lp[v]);
+                (gainHigh[v] * xv + gainDiff[v] * lp[v]).copyToRawArray (y + v * lanes);
+            }
+
+            hadamard<N> (y);
+
+            // feed back + inject the input, even lines left, odd lines right
+            const float injL = inL * inNorm, injR = inR * inNorm;
+            for (int k = 0; k < N; ++k)
+                lines[k * ringSize + pos] = y[k] * mixNorm + ((k & 1) ? injR : injL);
+
+            pos = (pos + 1) & mask;
+
+            // width as in juce::Reverb: mid/side blend of the wet pair
+            wetL *= outNorm;  wetR *= outNorm;
+            const float w1 = 0.5f * (1.0f + wetWidth), w2 = 0.5f * (1.0f - wetWidth);
+            const float outL = w1 * wetL + w2 * wetR;
+            const float outR = w1 * wetR + w2 * wetL;
+
+            if (right != nullptr)
+            {
+                left[i]  = outL * wetGain;
+                right[i] = outR * wetGain;
+            }
+            else
+            {
+                left[i] = 0.5f * (outL + outR) * wetGain;
+            }
+        }
+
+        // keep the rotator on the unit circle
+        const float g = 1.5f - 0.5f * (lfoC * lfoC + lfoS * lfoS);
+        lfoC *= g;  lfoS *= g;
+    }
+
+    /** Unnormalised fast Walsh–Hadamard transform of N values, in place. */
+    template <int N>
+    static void hadamard (float* y) noexcept
+    {
+        // strides ≥ one register: whole-register butterflies
+        for (int h = lanes; h < N; h *= 2)
+            for (int i = 0; i < N; i += 2 * h)
+                for (int j = i; j < i + h; j += lanes)
+                {
+                    const auto a = Vec::fromRawArray (y + j);
+                    const auto b = Vec::fromRawArray (y + j + h);
+                    (a + b).copyToRawArray (y + j);
+                    (a - b).copyToRawArray (y + j + h);
+                }
+
+        // strides inside a register
+        for (int h = 1; h < lanes && h < N; h *= 2)
+            for (int i = 0; i < N; i += 2 * h)
+                for (int j = i; j < i + h; ++j)
+                {
+                    const float a = y[j], b = y[j + h];
+                    y[j] = a + b;
+                    y[j + h] = a - b;
+                }
+    }
+
+    static int nextPrime (int n) noexcept
+    {
+        n = juce::jmax (n, 3) | 1;
+        for (;; n += 2)
+        {
+            bool prime = true;
+            for (int d = 3; d * d <= n; d += 2)
+                if (n % d == 0) { prime = false; break; }
+            if (prime)
+                return n;
+        }
+    }
+
+    struct Memory
+    {
+        explicit Memory (int size) : ringSize (size) { data.calloc ((size_t) maxLines * (size_t) size); }
+        juce::HeapBlock<float> data;      // maxLines rings of ringSize
+        int ringSize;
+    };
+
+    std::unique_ptr<Memory> live;                         // audio thread only
+    std::atomic<Memory*>    pending  { nullptr };         // message → audio
+    std::atomic<Memory*>    retired  { nullptr };         // audio → message
+    std::atomic<bool>       memoryWanted { false };
+
+    int ringSize = 0, mask = 0, pos = 0;
+    double fs = 44100.0;
+
+    Settings settings;
+    int   numLines = 16, maxLinesAllowed = maxLines;
+    float len[maxLines] {}, phC[maxLines] {}, phS[maxLines] {};
+    float depth = 0.0f;
+    float lfoC = 1.0f, lfoS = 0.0f, rotC = 1.0f, rotS = 0.0f;
+
+    Vec gainHigh[maxLines / lanes], gainDiff[maxLines / lanes], lpAlpha[maxLines / lanes], lp[maxLines / lanes];
+
+    float wetGain = 0.33f * wetScale, wetWidth = 1.0f;
+};
@@ -0,0 +1,428 @@
+#include "HalfBandResampler.h"
+#include <cmath>
+#include <cstring>
+
+//----------------------------------------------------------------------
+// design helpers
+namespace
+{
+    // Polyphase IIR half-band design (elliptic, after L. de Soras' "hiir").
+    // Returns numCoefs allpass coefficients; even indices feed branch 0.
+    double accNum (double q, int order, int c)
+    {
+        double acc = 0.0, term = 0.0;
+        int i = 0, sign = 1;
+        do
+        {
+            term = std::pow (q, double (i * (i + 1)))
+                 * std::sin ((i * 2 + 1) * c * juce::MathConstants<double>::pi / order) * sign;
+            acc += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs (term) > 1e-100);
+        return acc;
+    }
+
+    double accDen (double q, int order, int c)
+    {
+        double acc = 0.0, term = 0.0;
+        int i = 1, sign = -1;
+        do
+        {
+            term = std::pow (q, double (i * i))
+                 * std::cos (i * 2 * c * juce::MathConstants<double>::pi / order) * sign;
+            acc += term;
+            sign = -sign;
+            ++i;
+        } while (std::abs (term) > 1e-100);
+        return acc;
+    }
+
+    std::vector<double> designPolyphaseIir (int numCoefs, double transition)
+    {
+        double k = std::tan ((1.0 - transition * 2.0) * juce::MathConstants<double>::pi / 4.0);
+        k *= k;
+        const double kksqrt = std::pow (1.0 - k * k, 0.25);
+        const double e  = 0.5 * (1.0 - kksqrt) / (1.0 + kksqrt);
+        const double e4 = e * e * e * e;
+        const double q  = e * (1.0 + e4 * (2.0 + e4 * (15.0 + 150.0 * e4)));
+
+        const int order = numCoefs * 2 + 1;
+        std::vector<double> coefs ((size_t) numCoefs);
+
+        for (int index = 0; index < numCoefs; ++index)
+        {
+            const int c = index + 1;
+            const double ww   = accNum (q, order, c) * std::pow (q, 0.25) / (accDen (q, order, c) + 0.5);
+            const double wwsq = ww * ww;
+            const double x    = std::sqrt ((1.0 - wwsq * k) * (1.0 - wwsq / k)) / (1.0 + wwsq);
+            coefs[(size_t) index] = (1.0 - x) / (1.0 + x);
+        }
+        return coefs;
+    }
+
+    double besselI0 (double x)
+    {
+        double sum = 1.0, term = 1.0;
+        for (int k = 1; k < 40; ++k)
+        {
+            const double t = x / (2.0 * k);
+            term *= t * t;
+            sum  += term;
+        }
+        return sum;
+    }
+}
+
+//----------------------------------------------------------------------
+// construction
+HalfBandResampler::HalfBandResampler (size_t channels, size_t numStages, Kernel k)
+    : numChannels ((int) channels),
+      numGroups   (((int) channels + chPerVec - 1) / chPerVec),
+      kernel      (k),
+      stages      (numStages)
+{
+    static_assert (lanes >= 2, "need at least two SIMD lanes");
+
+    latency = 0.0f;
+    for (size_t s = 0; s < stages.size(); ++s)
+    {
+        auto& st = stages[s];
+        const double rateScale = 1.0 / double (size_t (1) << s);   // stage low rate → base samples
+
+        if (kernel == Kernel::minimumPhase)
+        {
+            // first stage carries the steep transition, later ones only have
+            // to reject images far away from the (already band-limited) signal
+            if (s == 0) prepareIirStage (st, 8, 0.04);
+            else        prepareIirStage (st, 4, 0.10);
+
+            // DC group delay of each first-order allpass is (1-a)/(1+a) low-rate
+            // samples; the half-sample branch offset of the up stage is undone
+            // by the swapped branch order of the down stage.
+            alignas (sizeof (Vec)) float c[lanes] {};
+            double d0 = 0.0, d1 = 0.0;
+            for (int sec = 0; sec < st.sections; ++sec)
+            {
+                st.coef[(size_t) sec].copyToRawArray (c);
+                d0 += (1.0 - c[0]) / (1.0 + c[0]);
+                d1 += (1.0 - c[1]) / (1.0 + c[1]);
+            }
+            latency += float ((d0 + d1) * rateScale);
+        }
+        else
+        {
+            if (s == 0) prepareFirStage (st, 16, 8.0);
+            else        prepareFirStage (st, 8,  8.0);
+
+            // centre tap 2M-1 at the upper rate, once up and once down
+            latency += float ((2 * st.M - 1) * rateScale);
+        }
+    }
+}
+
+void HalfBandResampler::prepareIirStage (Stage& st, int numCoefs, double transition)
+{
+    const auto a = designPolyphaseIir (numCoefs, transition);
+    st.sections = numCoefs / 2;
+
+    st.coef.clear();
+    for (int sec = 0; sec < st.sections; ++sec)
+    {
+        alignas (sizeof (Vec)) float c[lanes] {};
+        for (int l = 0; l + 1 < lanes; l += 2)
+        {
+            c[l]     = (float) a[(size_t) (2 * sec)];
+            c[l + 1] = (float) a[(size_t) (2 * sec + 1)];
+        }
+        st.coef.push_back (Vec::fromRawArray (c));
+    }
+
+    const auto numState = (size_t) (numGroups * st.sections);
+    st.upX  .assign (numState, Vec::expand (0.0f));
+    st.upY  .assign (numState, Vec::expand (0.0f));
+    st.downX.assign (numState, Vec::expand (0.0f));
+    st.downY.assign (numState, Vec::expand (0.0f));
+}
+
+void HalfBandResampler::prepareFirStage (Stage& st, int M, double beta)
+{
+    // h[i], i = 0 … 4M-2, centre c = 2M-1. Odd offsets from the centre are
+    // the only non-zero taps besides h[c] = 0.5; they sit at even i.
+    st.M = M;
+    st.fir.assign ((size_t) (2 * M), 0.0f);
+
+    const int    centre = 2 * M - 1;
+    const double i0b    = besselI0 (beta);
+    double sum = 0.0;
+
+    for (int j = 0; j < 2 * M; ++j)
+    {
+        const double n  = double (2 * j - centre);                       // odd
+        const double r  = n / double (centre);
+        const double w  = besselI0 (beta * std::sqrt (juce::jmax (0.0, 1.0 - r * r))) / i0b;
+        const double h  = std::sin (juce::MathConstants<double>::halfPi * n)
+                        / (juce::MathConstants<double>::pi * n);
+        st.fir[(size_t) j] = float (h * w);
+        sum += h * w;
+    }
+
+    // each polyphase branch of a unity-gain half-band sums to 0.5
+    for (auto& h : st.fir)
+        h = float (h * 0.5 / sum);
+}
+
+void HalfBandResampler::initProcessing (size_t maximumBaseBlockSize)
+{
+    maxBaseBlock = maximumBaseBlockSize;
+    const int maxN = (int) maximumBaseBlockSize;
+
+    for (size_t s = 0; s < stages.size(); ++s)
+    {
+        auto& st = stages[s];
+        const int lowN = maxN << s;
+
+        st.high.setSize (numChannels, lowN * 2);
+
+        if (kernel == Kernel::linearPhase)
+        {
+            st.upHist   .setSize (numChannels, 2 * st.M - 1 + lowN);
+            st.downHistE.setSize (numChannels, 2 * st.M - 1 + lowN);
+            st.downHistO.setSize (numChannels, st.M + lowN);
+        }
+    }
+
+    firScratch.setSize (1, maxN << juce::jmax (0, (int) stages.size() - 1));
+    reset();
+}
+
+void HalfBandResampler::reset() noexcept
+{
+    for (auto& st : stages)
+    {
+        for (auto* v : { &st.upX, &st.upY, &st.downX, &st.downY })
+            std::fill (v->begin(), v->end(), Vec::expand (0.0f));
+
+        st.upHist.clear();
+        st.downHistE.clear();
+        st.downHistO.clear();
+        st.high.clear();
+    }
+}
+
+//----------------------------------------------------------------------
+// block interface
+juce::dsp::AudioBlock<float> HalfBandResampler::processSamplesUp (const juce::dsp::AudioBlock<const float>& input) noexcept
+{
+    const auto n = input.getNumSamples();
+    jassert (n <= maxBaseBlock);
+
+    auto& last = stages.back().high;
+    juce::dsp::AudioBlock<float> os = juce::dsp::AudioBlock<float> (last)
+                                          .getSubsetChannelBlock (0, input.getNumChannels())
+                                          .getSubBlock (0, n * getOversamplingFactor());
+    upsample (input, os);
+    return os;
+}
+
+void HalfBandResampler::processSamplesDown (juce::dsp::AudioBlock<float>& output) noexcept
+{
+    const auto n = output.getNumSamples();
+    jassert (n <= maxBaseBlock);
+
+    auto& last = stages.back().high;
+    auto os = juce::dsp::AudioBlock<const float> (last.getArrayOfReadPointers(),
+                                                  output.getNumChannels(),
+                                                  n * getOversamplingFactor());
+    downsample (os, output);
+}
+
+void HalfBandResampler::upsample (const juce::dsp::AudioBlock<const float>& lowIn,
+                                  juce::dsp::AudioBlock<float>& highOut) noexcept
+{
+    jassert ((int) lowIn.getNumChannels() <= numChannels);
+    jassert (highOut.getNumSamples() == lowIn.getNumSamples() * getOversamplingFactor());
+
+    const int chans = (int) lowIn.getNumChannels();
+    const float* in[16];
+    float* out[16];
+    jassert (chans <= 16);
+
+    int lowN = (int) lowIn.getNumSamples();
+    for (size_t s = 0; s < stages.size(); ++s)
+    {
+        const bool lastStage = (s + 1 == stages.size());
+        for (int ch = 0; ch < chans; ++ch)
+        {
+            in[ch]  = (s == 0)   ? lowIn.getChannelPointer ((size_t) ch)
+                                 : stages[s - 1].high.getReadPointer (ch);
+            out[ch] = lastStage  ? highOut.getChannelPointer ((size_t) ch)
+                                 : stages[s].high.getWritePointer (ch);
+        }
+        upStage (stages[s], in, out, chans, lowN);
+        lowN *= 2;
+    }
+}
+
+void HalfBandResampler::downsample (const juce::dsp::AudioBlock<const float>& highIn,
+                                    juce::dsp::AudioBlock<float>& lowOut) noexcept
+{
+    jassert ((int) lowOut.getNumChannels() <= numChannels);
+    jassert (highIn.getNumSamples() == lowOut.getNumSamples() * getOversamplingFactor());
+
+    const int chans = (int) lowOut.getNumChannels();
+    const float* in[16];
+    float* out[16];
+    jassert (chans <= 16);
+
+    // down stage s reads its upper rate and writes the one below, which for
+    // s > 0 is the upper-rate buffer of stage s-1
+    int lowN = (int) lowOut.getNumSamples() << (stages.size() - 1);
+    for (size_t s = stages.size(); s-- > 0;)
+    {
+        for (int ch = 0; ch < chans; ++ch)
+        {
+            in[ch]  = (s + 1 == stages.size()) ? highIn.getChannelPointer ((size_t) ch)
+                                               : stages[s].high.getReadPointer (ch);
+            out[ch] = (s == 0) ? lowOut.getChannelPointer ((size_t) ch)
+                               : stages[s - 1].high.getWritePointer (ch);
+        }
+        downStage (stages[s], in, out, chans, lowN);
+        lowN /= 2;
+    }
+}
+
+//----------------------------------------------------------------------
+// 2× stages
+void HalfBandResampler::upStage (Stage& st, const float* const* in, float* const* out, int chans, int numLow) noexcept
+{
+
+    if (kernel == Kernel::minimumPhase)
+    {
+        alignas (sizeof (Vec)) float buf[lanes] {};
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const int ch0 = g * chPerVec;
+            const int chN = juce::jmin (chans, ch0 + chPerVec);
+            if (chN <= ch0)
+                break;
+            Vec* x = st.upX.data() + g * st.sections;
+            Vec* y = st.upY.data() + g * st.sections;
+
+            for (int i = 0; i < numLow; ++i)
+            {
+                for (int ch = ch0; ch < chN; ++ch)
+                    buf[2 * (ch - ch0)] = buf[2 * (ch - ch0) + 1] = in[ch][i];
+
+                auto s = Vec::fromRawArray (buf);
+                for (int sec = 0; sec < st.sections; ++sec)
+                {
+                    const auto t = (s - y[sec]) * st.coef[(size_t) sec] + x[sec];
+                    x[sec] = s;
+                    y[sec] = t;
+                    s = t;
+                }
+                s.copyToRawArray (buf);
+
+                for (int ch = ch0; ch < chN; ++ch)
+                {
+                    out[ch][2 * i]     = buf[2 * (ch - ch0)];
+                    out[ch][2 * i + 1] = buf[2 * (ch - ch0) + 1];
+                }
+            }
+        }
+        return;
+    }
+
+    // linear phase: y[2n] = 2·Σ h[2j]·x[n-j],  y[2n+1] = x[n-(M-1)]
+    const int hl = 2 * st.M - 1;
+    float* even = firScratch.getWritePointer (0);
+
+    for (int ch = 0; ch < chans; ++ch)
+    {
+        float* hist = st.upHist.getWritePointer (ch);
+        std::memcpy (hist + hl, in[ch], sizeof (float) * (size_t) numLow);
+
+        juce::FloatVectorOperations::clear (even, numLow);
+        for (int j = 0; j < 2 * st.M; ++j)
+            juce::FloatVectorOperations::addWithMultiply (even, hist + hl - j, 2.0f * st.fir[(size_t) j], numLow);
+
+        const float* delayed = hist + st.M;
+        float* o = out[ch];
+        for (int i = 0; i < numLow; ++i)
+        {
+            o[2 * i]     = even[i];
+            o[2 * i + 1] = delayed[i];
+        }
+
+        std::memmove (hist, hist + numLow, sizeof (float) * (size_t) hl);
+    }
+}
+
+void HalfBandResampler::downStage (Stage& st, const float* const* in, float* const* out, int chans, int numLow) noexcept
+{
+
+    if (kernel == Kernel::minimumPhase)
+    {
+        alignas (sizeof (Vec)) float buf[lanes] {};
+
+        for (int g = 0; g < numGroups; ++g)
+        {
+            const int ch0 = g * chPerVec;
+            const int chN = juce::jmin (chans, ch0 + chPerVec);
+            if (chN <= ch0)
+                break;
+            Vec* x = st.downX.data() + g * st.sections;
+            Vec* y = st.downY.data() + g * st.sections;
+
+            for (int i = 0; i < numLow; ++i)
+            {
+                for (int ch = ch0; ch < chN; ++ch)
+                {
+                    buf[2 * (ch - ch0)]     = in[ch][2 * i + 1];
+                    buf[2 * (ch - ch0) + 1] = in[ch][2 * i];
+                }
+
+                auto s = Vec::fromRawArray (buf);
+                for (int sec = 0; sec < st.sections; ++sec)
+                {
+                    const auto t = (s - y[sec]) * st.coef[(size_t) sec] + x[sec];
+                    x[sec] = s;
+                    y[sec] = t;
+                    s = t;
+                }
+                s.copyToRawArray (buf);
+
+                for (int ch = ch0; ch < chN; ++ch)
+                    out[ch][i] = 0.5f * (buf[2 * (ch - ch0)] + buf[2 * (ch - ch0) + 1]);
+            }
+        }
+        return;
+    }
+
+    // linear phase: z[n] = Σ h[2j]·v[2(n-j)] + 0.5·v[2(n-M)+1]
+    const int hlE = 2 * st.M - 1;
+    const int hlO = st.M;
+
+    for (int ch = 0; ch < chans; ++ch)
+    {
+        float* histE = st.downHistE.getWritePointer (ch);
+        float* histO = st.downHistO.getWritePointer (ch);
+        const float* v = in[ch];
+
+        for (int i = 0; i < numLow; ++i)
+        {
+            histE[hlE + i] = v[2 * i];
+            histO[hlO + i] = v[2 * i + 1];
+        }
+
+        float* z = out[ch];
+        juce::FloatVectorOperations::multiply (z, histO, 0.5f, numLow);
+        for (int j = 0; j < 2 * st.M; ++j)
+            juce::FloatVectorOperations::addWithMultiply (z, histE + hlE - j, st.fir[(size_t) j], numLow);
+
+        std::memmove (histE, histE + numLow, sizeof (float) * (size_t) hlE);
+        std::memmove (histO, histO + numLow, sizeof (float) * (size_t) hlO);
+    }
+}
@@ -0,0 +1,80 @@
+#pragma once
+#include <JuceHeader.h>
+#include <vector>
+
+//==============================================================================
+// In-house 2^N half-band up/down-sampler, a drop-in for the parts of
+// juce::dsp::Oversampling we use (processSamplesUp/Down, latency, factor).
+//
+//  minimumPhase – polyphase allpass IIR (two first-order allpass chains per
+//                 2× stage). Both polyphase branches of up to two channels
+//                 share one SIMD register; samples still go in and out of it
+//                 through a small staging array each step.
+//  linearPhase  – Kaiser-windowed half-band FIR. Half the taps are zero and
+//                 the centre tap is a plain delay, so only one branch is
+//                 filtered, as block multiply-adds over contiguous history.
+//
+// Every stage keeps separate up and down state, so one instance can also be
+// used one-directionally (e.g. decimate, process at the low rate, interpolate).
+//
+// Not yet benchmarked against juce::dsp::Oversampling; don't assume it is the
+// faster of the two until it has been timed in a real build.
+//==============================================================================
+class HalfBandResampler
+{
+public:
+    enum class Kernel { minimumPhase, linearPhase };
+
+    HalfBandResampler (size_t numChannels, size_t numStages, Kernel kernel);
+
+    void   initProcessing (size_t maximumBaseBlockSize);
+    void   reset() noexcept;
+
+    size_t getOversamplingFactor() const noexcept { return size_t (1) << stages.size(); }
+    Kernel getKernel() const noexcept             { return kernel; }
+
+    /** Round-trip (up + down) group delay in base-rate samples. */
+    float  getLatencyInSamples() const noexcept   { return latency; }
+
+    // --- juce::dsp::Oversampling-style interface (internal OS buffer) --------
+    juce::dsp::AudioBlock<float> processSamplesUp (const juce::dsp::AudioBlock<const float>& input) noexcept;
+    void processSamplesDown (juce::dsp::AudioBlock<float>& output) noexcept;
+
+    // --- one-directional use: lowIn.getNumSamples() × factor == highOut's ----
+    void upsample   (const juce::dsp::AudioBlock<const float>& lowIn,  juce::dsp::AudioBlock<float>& highOut) noexcept;
+    void downsample (const juce::dsp::AudioBlock<const float>& highIn, juce::dsp::AudioBlock<float>& lowOut)  noexcept;
+
+private:
+    using Vec = juce::dsp::SIMDRegister<float>;
+    static constexpr int lanes     = (int) Vec::SIMDNumElements;
+    static constexpr int chPerVec  = lanes / 2;     // two polyphase branches per channel
+
+    struct Stage
+    {
+        // minimum phase: one register per allpass section, lanes = [a_even a_odd a_even a_odd …]
+        std::vector<Vec> coef, upX, upY, downX, downY;   // state: numGroups × sections
+        int sections = 0;
+
+        // linear phase: non-zero even-phase taps h[2j], j = 0 … 2M-1
+        std::vector<float> fir;
+        int M = 0;
+        juce::AudioBuffer<float> upHist, downHistE, downHistO;
+
+        juce::AudioBuffer<float> high;   // stage output at its upper rate
+    };
+
+    void prepareIirStage (Stage&, int numCoefs, double transition);
+    void prepareFirStage (Stage&, int M, double beta);
+
+    void upStage   (Stage&, const float* const* in, float* const* out, int numChannels, int numLow) noexcept;
+    void downStage (Stage&, const float* const* in, float* const* out, int numChannels, int numLow) noexcept;
+
+    int numChannels = 0, numGroups = 0;
+    Kernel kernel;
+    std::vector<Stage> stages;
+    juce::AudioBuffer<float> firScratch;
+    size_t maxBaseBlock = 0;
+    float  latency      = 0.0f;
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (HalfBandResampler)
+};
@@ -306,6 +306,18 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     addAndMakeVisible(consoleToggle);
     consoleToggleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(vts,"CONSOLE_ON",consoleToggle);
 
+    // --- Chorus / ensemble -----------------------------------------------------
+    addAndMakeVisible(chorusToggle);
+    chorusToggleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(vts,"CHORUS_ON",chorusToggle);
+    chorusModeBox.addItemList({ "Juno I", "Juno II", "Juno I+II", "Ensemble" }, 1);
+    addAndMakeVisible(chorusModeBox);
+    chorusModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(vts,"CHORUS_MODE",chorusModeBox);
+    chorusMixSlider.setSliderStyle(juce::Slider::LinearHorizontal);
+    chorusMixSlider.setTextBoxStyle(juce::Slider::TextBoxRight,false,50,20);
+    chorusMixSlider.setTooltip("Chorus mix");
+    addAndMakeVisible(chorusMixSlider);
+    chorusMixAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(vts,"CHORUS_MIX",chorusMixSlider);
+
     // NEW:  Pre‑amp model selector ---------------------------------------------
     consoleModelBox.addItemList({ "Tape Thick","Warm Tube","Deep Console",
                                   "Punch Glue","Sub Boom","Opto Smooth",
@@ -558,6 +570,18 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     addAndMakeVisible(delayFbLabel);
     delayFbAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(vts,"DELAY_FB",delayFeedbackSlider);
 
+    delayCrossSlider.setSliderStyle(juce::Slider::RotaryVerticalDrag);
+    delayCrossSlider.setTextBoxStyle(juce::Slider::TextBoxBelow,false,50,20);
+    addAndMakeVisible(delayCrossSlider);
+    delayCrossLabel.setText("X-FB", juce::dontSendNotification);
+    delayCrossLabel.attachToComponent(&delayCrossSlider,false);
+    delayCrossLabel.setJustificationType(juce::Justification::centredBottom);
+    addAndMakeVisible(delayCrossLabel);
+    delayCrossAttachment = std::make_unique<juce::AudioProcessorValueTreeState::SliderAttachment>(vts,"DELAY_CROSS",delayCrossSlider);
+
+    addAndMakeVisible(delayPingPongToggle);
+    delayPingPongAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(vts,"DELAY_PINGPONG",delayPingPongToggle);
+
     addAndMakeVisible(delaySyncToggle);
     delaySyncAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(vts,"DELAY_SYNC",delaySyncToggle);
 
@@ -595,6 +619,46 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     reverbTypeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
         vts, "REVERB_TYPE", reverbTypeBox);
 
+    // Reverb engine selector
+    reverbAlgoBox.addItemList({ "Freeverb", "FDN", "Convolution" }, 1);
+    addAndMakeVisible(reverbAlgoBox);
+    reverbAlgoAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        vts, "REVERB_ALGO", reverbAlgoBox);
+
+    // Reverb tank rate (Freeverb / FDN); saves CPU in 96/192 kHz sessions
+    reverbRateBox.addItemList({ "Full", "Half", "Quarter" }, 1);
+    reverbRateBox.setTooltip("Run the Freeverb/FDN tank at half or quarter rate (88.2 kHz and up)");
+    addAndMakeVisible(reverbRateBox);
+    reverbRateAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        vts, "REVERB_RATE", reverbRateBox);
+
+    // FX routing: inserts in series, or send/return with the mixes as send levels
+    fxRoutingBox.addItemList({ "Insert", "Send", "Send Mono" }, 1);
+    fxRoutingBox.setTooltip("Insert: delay into reverb. Send: Mix knobs set send levels, returns summed in parallel");
+    addAndMakeVisible(fxRoutingBox);
+    fxRoutingAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(
+        vts, "FX_ROUTING", fxRoutingBox);
+
+    // Impulse response for the convolution engine (WAV, memory-mapped)
+    addAndMakeVisible(irLoadButton);
+    irLoadButton.setTooltip("Load a WAV impulse response for the Convolution reverb");
+    irLoadButton.onClick = [this]()
+    {
+        irChooser = std::make_unique<juce::FileChooser>("Load impulse response", juce::File(), "*.wav");
+        irChooser->launchAsync(juce::FileBrowserComponent::openMode | juce::FileBrowserComponent::canSelectFiles,
+                               [this](const juce::FileChooser& fc)
+                               {
+                                   const auto file = fc.getResult();
+                                   if (file.existsAsFile() && processor.loadImpulseResponse(file))
+                                       irLoadButton.setButtonText(file.getFileNameWithoutExtension());
+                               });
+    };
+    {
+        const auto irFile = processor.getImpulseResponseFile();
+        if (irFile.existsAsFile())
+            irLoadButton.setButtonText(irFile.getFileNameWithoutExtension());
+    }
+
     // --- LFO Sync toggle & Shape selector ----------------------------------
     addAndMakeVisible(lfoSyncToggle);
     lfoSyncAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(
@@ -648,6 +712,16 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     addAndMakeVisible(delaySyncDivLabel);
     delaySyncDivAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(vts, "DELAY_SYNC_DIV", delaySyncDivBox);
 
+    // Delay type and Multi-Tap pattern
+    delayTypeBox.addItemList({"Digital","Tape","BBD","Multi-Tap"}, 1);
+    addAndMakeVisible(delayTypeBox);
+    delayTypeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(vts, "DELAY_TYPE", delayTypeBox);
+    delayTapsBox.addItemList({"Quarters","Dotted","Triplets","Golden","Cascade"}, 1);
+    addAndMakeVisible(delayTapsBox);
+    delayTapsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ComboBoxAttachment>(vts, "DELAY_TAPS", delayTapsBox);
+    delayTypeBox.onChange = [this] { delayTapsBox.setEnabled (delayTypeBox.getSelectedId() == 4); };   // Multi-Tap only
+    delayTypeBox.onChange();
+
     addAndMakeVisible(reverbToggle);
     reverbToggleAttachment = std::make_unique<juce::AudioProcessorValueTreeState::ButtonAttachment>(vts,"REVERB_ON",reverbToggle);
 
@@ -790,7 +864,7 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
                         &osc1VolSlider, &osc2VolSlider, &osc2SemiSlider, &osc2FineSlider,
                         &lfoRateSlider, &lfoDepthSlider,
                         &delayMixSlider, &reverbMixSlider, &reverbSizeSlider,
-                        &delayTimeSlider, &delayFeedbackSlider,
+                        &delayTimeSlider, &delayFeedbackSlider, &delayCrossSlider,
                         &noiseMixSlider,&driveAmtSlider,
                         &masterGainSlider})
     {
@@ -813,7 +887,7 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     // Style labels
     for (auto* lbl: {&attackLabel,&decayLabel,&sustainLabel,&releaseLabel,&cutoffLabel,&resonanceLabel,
                     &waveformLabel,&pulseWidthLabel,&modelLabel,&osc1VolLabel,&osc2VolLabel,&waveform2Label,
-                    &lfoRateLabel,&lfoDepthLabel,&delayMixLabel,&delayTimeLabel,&delayFbLabel,
+                    &lfoRateLabel,&lfoDepthLabel,&delayMixLabel,&delayTimeLabel,&delayFbLabel,&delayCrossLabel,
                     &delaySyncDivLabel,
                     &reverbMixLabel, &reverbTypeLabel, &reverbSizeLabel,
                     &noiseMixLabel,&driveAmtLabel,&companyLabel,
@@ -823,7 +897,7 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     }
     
     // Style combo boxes
-    for (auto* cb: {&companyBox,&modelBox,&waveformBox,&waveform2Box,&lfoShapeBox,&presetCategoryBox,&presetBox,&consoleModelBox, &delaySyncDivBox}) {
+    for (auto* cb: {&companyBox,&modelBox,&waveformBox,&waveform2Box,&lfoShapeBox,&presetCategoryBox,&presetBox,&consoleModelBox, &delaySyncDivBox, &delayTypeBox, &delayTapsBox, &reverbAlgoBox, &reverbRateBox, &fxRoutingBox, &chorusModeBox}) {
         cb->setColour(juce::ComboBox::backgroundColourId, controlBgColor);
         cb->setColour(juce::ComboBox::textColourId, textColor);
         cb->setColour(juce::ComboBox::arrowColourId, accentColor);
@@ -833,7 +907,7 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     
     // Style toggle buttons
     for (auto* b : { &lfoToggle, &lfoSyncToggle, &lfoToPitchToggle, &lfoToCutoffToggle, &lfoToAmpToggle, &noiseToggle, &driveToggle,
-                     &delayToggle, &reverbToggle, &delaySyncToggle, &consoleToggle,
+                     &delayToggle, &reverbToggle, &delaySyncToggle, &delayPingPongToggle, &consoleToggle, &chorusToggle,
                      &freePhaseToggle, &driftToggle, &filterTolToggle,
                      &vcaClipToggle, &humToggle, &crossToggle,
                      &analogEnvToggle, &legatoToggle })
@@ -854,8 +928,8 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     for (auto* sw: {&attackSlider,&decaySlider,&sustainSlider,&releaseSlider,
                    &cutoffSlider,&resonanceSlider,&pulseWidthSlider,
                    &osc1VolSlider,&osc2VolSlider,&osc2SemiSlider,&osc2FineSlider,&lfoRateSlider,&lfoDepthSlider,
-                   &delayMixSlider,&reverbMixSlider,&delayTimeSlider,&delayFeedbackSlider,
-                   &noiseMixSlider,&driveAmtSlider,
+                   &delayMixSlider,&reverbMixSlider,&delayTimeSlider,&delayFeedbackSlider,&delayCrossSlider,
+                   &noiseMixSlider,&driveAmtSlider,&chorusMixSlider,
                    &masterGainSlider}) {
         sw->setColour(juce::Slider::thumbColourId, accentColor);
         sw->setColour(juce::Slider::trackColourId, sliderTrackColor);
@@ -965,7 +1039,7 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     }
 
     // FX sliders: separate delay and reverb colours
-    for (auto* slider : {&delayMixSlider, &delayTimeSlider, &delayFeedbackSlider}) {
+    for (auto* slider : {&delayMixSlider, &delayTimeSlider, &delayFeedbackSlider, &delayCrossSlider}) {
         slider->setColour(juce::Slider::rotarySliderFillColourId, juce::Colour(88, 97, 224));  // Purple (delay)
         slider->setColour(juce::Slider::thumbColourId, juce::Colour(88, 97, 224));
     }
@@ -985,6 +1059,10 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     consoleModelBox.setColour(juce::ComboBox::arrowColourId, juce::Colour(97, 224, 88));  // Lime (reverb)
     reverbTypeBox.setColour(juce::ComboBox::buttonColourId, juce::Colour(97, 224, 88).darker(0.2f));  // Darker lime
     consoleModelBox.setColour(juce::ComboBox::buttonColourId, juce::Colour(97, 224, 88).darker(0.2f));  // Darker lime
+    reverbAlgoBox.setColour(juce::ComboBox::arrowColourId, juce::Colour(97, 224, 88));  // Lime (reverb)
+    reverbAlgoBox.setColour(juce::ComboBox::buttonColourId, juce::Colour(97, 224, 88).darker(0.2f));  // Darker lime
+    reverbRateBox.setColour(juce::ComboBox::arrowColourId, juce::Colour(97, 224, 88));  // Lime (reverb)
+    reverbRateBox.setColour(juce::ComboBox::buttonColourId, juce::Colour(97, 224, 88).darker(0.2f));  // Darker lime
 
     // Toggles with matching section colours
     lfoToggle.setColour(juce::TextButton::buttonOnColourId, lfoColour);
@@ -993,8 +1071,10 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
 
     delayToggle.setColour(juce::TextButton::buttonOnColourId, juce::Colour(88, 97, 224));  // Purple (delay)
     delaySyncToggle.setColour(juce::TextButton::buttonOnColourId, juce::Colour(88, 97, 224));  // Purple (delay)
+    delayPingPongToggle.setColour(juce::TextButton::buttonOnColourId, juce::Colour(88, 97, 224));  // Purple (delay)
     reverbToggle.setColour(juce::TextButton::buttonOnColourId, juce::Colour(97, 224, 88));  // Lime (reverb)
     consoleToggle.setColour(juce::TextButton::buttonOnColourId, juce::Colour(97, 224, 88));  // Lime (reverb)
+    chorusToggle.setColour(juce::TextButton::buttonOnColourId, juce::Colour(97, 224, 88));  // Lime (reverb)
     // =========================================================================
 
     // Build the cached background once:
@@ -1032,13 +1112,81 @@ AllSynthPluginAudioProcessorEditor::AllSynthPluginAudioProcessorEditor(AllSynthP
     filterOsLabel.setText ("OS", juce::dontSendNotification);
     addAndMakeVisible (filterOsLabel);
 
-    filterOsBox.addItemList ({ "Off", "2× IIR", "4× IIR", "2× FIR", "4× FIR" }, 1);
+    filterOsBox.addItemList ({ "Off", "2× IIR", "4× IIR", "2× FIR", "4× FIR", "Auto" }, 1);
     addAndMakeVisible (filterOsBox);
 
     filterOsAttachment = std::make_unique<juce::AudioProcessorValueTreeState::
                           ComboBoxAttachment>(processor.getValueTreeState(),
                                               "FILTER_OS", filterOsBox);
 
+    // --- Voice stereo placement --------------------------------
+    voicePanLabel.setText ("Voice Pan", juce::dontSendNotification);
+    voicePanLabel.attachToComponent (&voicePanBox, false);
+    voicePanLabel.setJustificationType (juce::Justification::centredBottom);
+    addAndMakeVisible (voicePanLabel);
+
+    voicePanBox.addItemList ({ "Off", "Alternate", "Random", "Note" }, 1);
+    addAndMakeVisible (voicePanBox);
+    voicePanAttachment = std::make_unique<juce::AudioProcessorValueTreeState::
+                          ComboBoxAttachment>(processor.getValueTreeState(),
+                                              "VOICE_PAN_MODE", voicePanBox);
+
+    voiceSpreadSlider.setSliderStyle (juce::Slider::LinearHorizontal);
+    voiceSpreadSlider.setTextBoxStyle (juce::Slider::TextBoxRight, false, 45, 20);
+    addAndMakeVisible (voiceSpreadSlider);
+    voiceSpreadLabel.setText ("Spread", juce::dontSendNotification);
+    voiceSpreadLabel.attachToComponent (&voiceSpreadSlider, false);
+    voiceSpreadLabel.setJustificationType (juce::Justification::centredBottom);
+    addAndMakeVisible (voiceSpreadLabel);
+    voiceSpreadAttachment = std::make_unique<juce::AudioProcessorValueTreeState::
+                             SliderAttachment>(processor.getValueTreeState(),
+                                               "VOICE_SPREAD", voiceSpreadSlider);
+
+    // --- Mono engine ------------------------------------------
+    monoModeLabel.setText ("Mono", juce::dontSendNotification);
+    monoModeLabel.attachToComponent (&monoModeBox, false);
+    monoModeLabel.setJustificationType (juce::Justification::centredBottom);
+    addAndMakeVisible (monoModeLabel);
+
+    monoModeBox.addItemList ({ "Off", "Last", "Low", "High" }, 1);
+    addAndMakeVisible (monoModeBox);
+    monoModeAttachment = std::make_unique<juce::AudioProcessorValueTreeState::
+                          ComboBoxAttachment>(processor.getValueTreeState(),
+                                              "MONO_MODE", monoModeBox);
+
+    glideSlider.setSliderStyle (juce::Slider::LinearHorizontal);
+    glideSlider.setTextBoxStyle (juce::Slider::TextBoxRight, false, 45, 20);
+    addAndMakeVisible (glideSlider);
+    glideLabel.setText ("Glide", juce::dontSendNotification);
+    glideLabel.attachToComponent (&glideSlider, false);
+    glideLabel.setJustificationType (juce::Justification::centredBottom);
+    addAndMakeVisible (glideLabel);
+    glideAttachment = std::make_unique<juce::AudioProcessorValueTreeState::
+                       SliderAttachment>(processor.getValueTreeState(),
+                                         "GLIDE", glideSlider);
+
+    // --- Quality tier -----------------------------------------
+    qualityLabel.setText ("Quality", juce::dontSendNotification);
+    addAndMakeVisible (qualityLabel);
+
+    qualityBox.addItemList ({ "Custom", "Eco", "Standard", "HQ" }, 1);
+    qualityBox.setTooltip ("Eco: live / small buffers   Standard: everyday   HQ: mixdown\n"
+                           "Custom: use the OS selectors below");
+    addAndMakeVisible (qualityBox);
+
+    // The tier overrides the individual OS selectors, so grey them out
+    qualityBox.onChange = [this]
+    {
+        const bool custom = (qualityBox.getSelectedId() <= 1);
+        filterOsBox.setEnabled (custom);
+        enhOsBox.setEnabled (custom);
+    };
+
+    qualityAttachment = std::make_unique<juce::AudioProcessorValueTreeState::
+                         ComboBoxAttachment>(processor.getValueTreeState(),
+                                             "QUALITY", qualityBox);
+    qualityBox.onChange();
+
 }
 
 //==============================================================================
@@ -1255,8 +1403,8 @@ void AllSynthPluginAudioProcessorEditor::resized()
     osc2FineLabel.setTopLeftPosition(osc2FineSlider.getX(),
                                      osc2FineSlider.getY() - 20);
 
-    // Synth model dropdowns - also narrower
-    auto modelRowHeight = modelArea.getHeight() / 2;
+    // Synth model dropdowns - also narrower (third row: voice placement)
+    auto modelRowHeight = modelArea.getHeight() / 3;
     auto modelDropdownWidthRatio = 0.7f; // Ratio for the dropdown itself
     auto totalModelControlWidth = modelArea.getWidth() * modelDropdownWidthRatio;
     auto modelDropdownWidth = totalModelControlWidth - (2 * buttonWidth + 2 * buttonGap); // Width for ComboBox
@@ -1272,7 +1420,7 @@ void AllSynthPluginAudioProcessorEditor::resized()
     companyDownButton.setBounds(companyControlBounds);
     companyLabel.setTopLeftPosition(companyBox.getX(), companyBox.getY() - 25);
 
-    auto modelAreaFull = modelArea;
+    auto modelAreaFull = modelArea.removeFromTop(modelRowHeight);
     auto modelControlBounds = modelAreaFull.withSizeKeepingCentre(totalModelControlWidth, modelDropdownHeight);
     modelBox.setBounds(modelControlBounds.removeFromLeft(modelDropdownWidth));
     modelControlBounds.removeFromLeft(buttonGap);
@@ -1281,6 +1429,14 @@ void AllSynthPluginAudioProcessorEditor::resized()
     modelDownButton.setBounds(modelControlBounds);
     modelLabel.setTopLeftPosition(modelBox.getX(), modelBox.getY() - 25);
 
+    // Voice row: pan mode | spread | mono mode | glide
+    auto placementRow = modelArea.withSizeKeepingCentre(totalModelControlWidth, modelDropdownHeight);
+    const int placementCell = placementRow.getWidth() / 4;
+    voicePanBox.setBounds(placementRow.removeFromLeft(placementCell).withTrimmedRight(buttonGap));
+    voiceSpreadSlider.setBounds(placementRow.removeFromLeft(placementCell).withTrimmedRight(buttonGap));
+    monoModeBox.setBounds(placementRow.removeFromLeft(placementCell).withTrimmedRight(buttonGap));
+    glideSlider.setBounds(placementRow);
+
     // --- Column 2: Filter & Amp Envelope ---
     auto filterSectionHeight = filterEnvArea.getHeight() * 0.30f; // Less space for filter
     auto envSectionHeight    = filterEnvArea.getHeight() * 0.70f; // More space for Env
@@ -1292,8 +1448,11 @@ void AllSynthPluginAudioProcessorEditor::resized()
     const int osBoxHeight = 25;
     auto osRow = filterArea.removeFromTop(osBoxHeight);
     const int osBoxWidth = 60;
+    auto qualityCell = osRow.removeFromLeft(osRow.getWidth() / 2);
     filterOsBox.setBounds(osRow.withSizeKeepingCentre(osBoxWidth, osBoxHeight));
     filterOsLabel.setTopLeftPosition(filterOsBox.getX(), filterOsBox.getY() - 18);
+    qualityBox.setBounds(qualityCell.withSizeKeepingCentre(osBoxWidth + 30, osBoxHeight));
+    qualityLabel.setBounds(qualityBox.getX(), qualityBox.getY() - 18, qualityBox.getWidth(), 18);
 
     // Remaining area for cutoff / resonance sliders
     auto filterSliderWidth = filterArea.getWidth() / 2;
@@ -1363,6 +1522,9 @@ void AllSynthPluginAudioProcessorEditor::resized()
     auto fxSliderPadding = 12; // Adjusted padding for sliders
     auto fxSectionGap = 20; // Added gap between Delay and Reverb sections
 
+    // FX routing row above both effects
+    fxRoutingBox.setBounds(fxArea.removeFromTop(comboBoxHeight).reduced(fxPaddingX, fxPaddingY / 2));
+
     // --- DELAY SECTION ---
     // Allocate area for delay section
     auto delayArea = fxArea.removeFromTop(fxArea.getHeight() * 0.45f);
@@ -1375,7 +1537,14 @@ void AllSynthPluginAudioProcessorEditor::resized()
 
     // Delay toggle in its own row at top
     auto delayToggleRow = delayArea.removeFromTop(toggleHeight);
+    auto pingPongCell   = delayToggleRow.removeFromRight(delayToggleRow.getWidth() / 2);
     delayToggle.setCentrePosition(delayToggleRow.getCentreX(), delayToggleRow.getCentreY());
+    delayPingPongToggle.setCentrePosition(pingPongCell.getCentreX(), pingPongCell.getCentreY());
+
+    // Delay type + Multi-Tap pattern row
+    auto delayTypeRow = delayArea.removeFromTop(comboBoxHeight);
+    delayTapsBox.setBounds(delayTypeRow.removeFromRight(delayTypeRow.getWidth() / 2).reduced(fxPaddingX, fxPaddingY));
+    delayTypeBox.setBounds(delayTypeRow.reduced(fxPaddingX, fxPaddingY));
     
     // Split remaining delay area into two columns
     auto delayLeftColumn = delayArea.removeFromLeft(delayArea.getWidth() / 2);
@@ -1392,9 +1561,11 @@ void AllSynthPluginAudioProcessorEditor::resized()
     delaySyncDivBox.setBounds(divRowArea.reduced(fxPaddingX, fxPaddingY));
     delaySyncDivLabel.setTopLeftPosition(delaySyncDivBox.getX(), delaySyncDivBox.getY() - 25);
     
-    // Right column: Delay Feedback
-    delayTimeSlider.setBounds(delayRightColumn.removeFromTop(delayRightColumn.getHeight() * 0.5f).reduced(fxSliderPadding));
-    delayFeedbackSlider.setBounds(delayRightColumn.reduced(fxSliderPadding));
+    // Right column: Delay Time, Feedback, Cross-feedback
+    const int delayRightRow = delayRightColumn.getHeight() / 3;
+    delayTimeSlider.setBounds(delayRightColumn.removeFromTop(delayRightRow).reduced(fxSliderPadding));
+    delayFeedbackSlider.setBounds(delayRightColumn.removeFromTop(delayRightRow).reduced(fxSliderPadding));
+    delayCrossSlider.setBounds(delayRightColumn.reduced(fxSliderPadding));
 
     fxArea.removeFromTop(fxSectionGap); // Add vertical space between Delay and Reverb
 
@@ -1404,7 +1575,9 @@ void AllSynthPluginAudioProcessorEditor::resized()
     
     // Reverb toggle in its own row at top
     auto reverbToggleRow = reverbArea.removeFromTop(toggleHeight);
+    auto irLoadCell      = reverbToggleRow.removeFromRight(reverbToggleRow.getWidth() / 2);
     reverbToggle.setCentrePosition(reverbToggleRow.getCentreX(), reverbToggleRow.getCentreY());
+    irLoadButton.setBounds(irLoadCell.reduced(5, 5));
     
     // Split remaining reverb area into two columns
     auto reverbLeftColumn = reverbArea.removeFromLeft(reverbArea.getWidth() / 2);
@@ -1414,16 +1587,24 @@ void AllSynthPluginAudioProcessorEditor::resized()
     reverbMixSlider.setBounds(reverbLeftColumn.removeFromTop(reverbLeftColumn.getHeight() * 0.7f).reduced(fxSliderPadding));
     reverbTypeBox.setBounds(reverbLeftColumn.reduced(fxPaddingX, fxPaddingY));
     
-    // Right column: Reverb Size
-    reverbSizeSlider.setBounds(reverbRightColumn.reduced(fxSliderPadding));
+    // Right column: Reverb Size, engine and tank rate
+    reverbSizeSlider.setBounds(reverbRightColumn.removeFromTop(reverbRightColumn.getHeight() * 0.7f).reduced(fxSliderPadding));
+    reverbRateBox.setBounds(reverbRightColumn.removeFromRight(reverbRightColumn.getWidth() / 2).reduced(fxPaddingX / 2, fxPaddingY));
+    reverbAlgoBox.setBounds(reverbRightColumn.reduced(fxPaddingX / 2, fxPaddingY));
 
     fxArea.removeFromTop(fxSectionGap); // Add vertical space between Reverb and Console
 
-    // --- CONSOLE SECTION ---
+    // --- CONSOLE + CHORUS SECTION ---
     auto consoleToggleRow = fxArea.removeFromTop(toggleHeight);
+    auto chorusToggleCell = consoleToggleRow.removeFromRight(consoleToggleRow.getWidth() / 2);
     consoleToggle.setCentrePosition(consoleToggleRow.getCentreX(), consoleToggleRow.getCentreY());
+    chorusToggle.setCentrePosition(chorusToggleCell.getCentreX(), chorusToggleCell.getCentreY());
     consoleModelBox.setBounds(fxArea.removeFromTop(comboBoxHeight).reduced(fxPaddingX, fxPaddingY / 2));
 
+    auto chorusRow = fxArea.removeFromTop(comboBoxHeight);
+    chorusModeBox.setBounds(chorusRow.removeFromLeft(chorusRow.getWidth() / 2).reduced(fxPaddingX / 2, fxPaddingY / 2));
+    chorusMixSlider.setBounds(chorusRow.reduced(fxPaddingX / 2, fxPaddingY / 2));
+
     consoleModelLabel.setTopLeftPosition(consoleModelBox.getX(), consoleModelBox.getY() - 25);
     
     // ===== single bottom row for all toggles (analog-extras + enhancements) ==========
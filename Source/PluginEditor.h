@@ -40,7 +40,9 @@ private:
                       delayToggle   { "Delay" },
                       reverbToggle  { "Reverb" },
                       delaySyncToggle{ "Sync" },
-                      consoleToggle { "Fat" };
+                      delayPingPongToggle{ "Ping-Pong" },
+                      consoleToggle { "Fat" },
+                      chorusToggle  { "Chorus" };
     juce::Slider       lfoRateSlider, lfoDepthSlider;
     juce::TextButton   lfoSyncToggle { "Sync" };   // Tempo-sync toggle for LFO
     juce::ComboBox     lfoShapeBox;                   // LFO shape selector
@@ -57,20 +59,51 @@ private:
     // Noise & Drive
     juce::Slider       noiseMixSlider, driveAmtSlider;
     // FX
-    juce::Slider       delayMixSlider, reverbMixSlider, delayTimeSlider, delayFeedbackSlider;
+    juce::Slider       delayMixSlider, reverbMixSlider, delayTimeSlider, delayFeedbackSlider, delayCrossSlider;
     juce::Slider       reverbSizeSlider;    // NEW
     juce::ComboBox     reverbTypeBox;
+    juce::ComboBox     reverbAlgoBox;       // Freeverb / FDN / Convolution
+    juce::ComboBox     reverbRateBox;       // tank rate: Full / Half / Quarter
+    juce::ComboBox     fxRoutingBox;        // Insert / Send / Send Mono
+    juce::ComboBox     chorusModeBox;       // Juno I / II / I+II / Ensemble
+    juce::Slider       chorusMixSlider;
     // Console
     juce::ComboBox     consoleModelBox;          // NEW
     juce::Label        consoleModelLabel;        // NEW
     juce::ComboBox     delaySyncDivBox;     // delay sync division selector
     juce::Label        delaySyncDivLabel;   // delay sync division label
+    juce::ComboBox     delayTypeBox;        // Digital / Tape / BBD / Multi-Tap
+    juce::ComboBox     delayTapsBox;        // Multi-Tap head pattern
 
     // ===== Oversampling selector =====================================
     juce::ComboBox  filterOsBox;
     juce::Label     filterOsLabel;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
                      filterOsAttachment;
+
+    // ===== Voice stereo placement =====================================
+    juce::ComboBox  voicePanBox;
+    juce::Slider    voiceSpreadSlider;
+    juce::Label     voicePanLabel, voiceSpreadLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
+                     voicePanAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
+                     voiceSpreadAttachment;
+
+    // ===== Mono engine: note priority + glide ===========================
+    juce::ComboBox  monoModeBox;
+    juce::Slider    glideSlider;
+    juce::Label     monoModeLabel, glideLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
+                     monoModeAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
+                     glideAttachment;
+
+    // ===== Quality tier selector =======================================
+    juce::ComboBox  qualityBox;
+    juce::Label     qualityLabel;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
+                     qualityAttachment;
     // =========================================================================
 
     // --- NEW: Preset selectors -----------------------------------------------
@@ -89,7 +122,7 @@ private:
     juce::Label companyLabel;
     juce::Label osc1VolLabel, osc2VolLabel, waveform2Label;
     juce::Label lfoRateLabel, lfoDepthLabel, delayMixLabel, reverbMixLabel,
-                delayTimeLabel, delayFbLabel;
+                delayTimeLabel, delayFbLabel, delayCrossLabel;
     juce::Label noiseMixLabel, driveAmtLabel;
     juce::Label reverbSizeLabel, reverbTypeLabel;   // NEW size label
     juce::Label masterGainLabel;                    // Master gain label
@@ -112,19 +145,26 @@ private:
         reverbSizeAttachment,
         delayTimeAttachment, 
         delayFbAttachment,
+        delayCrossAttachment,
         noiseMixAttachment, 
         driveAmtAttachment,
-        lfoPhaseAttachment;   // LFO phase offset slider attachment
+        lfoPhaseAttachment,   // LFO phase offset slider attachment
+        chorusMixAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::SliderAttachment>
         masterGainAttachment;   // Master gain
     
     // ComboBox attachments
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>  
         reverbTypeAttachment,
+        reverbAlgoAttachment,
+        reverbRateAttachment,
+        fxRoutingAttachment,
+        chorusModeAttachment,
         consoleModelAttachment,
         lfoShapeAttachment,
         lfoSyncDivAttachment;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> delaySyncDivAttachment; // delay sync division attachment
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment> delayTypeAttachment, delayTapsAttachment;
     
     // ===== NEW analogue-extras toggles ========================================
     juce::TextButton freePhaseToggle{"FreePhase"}, 
@@ -144,7 +184,7 @@ private:
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment>
         freePhaseAtt, driftAtt, filterTolAtt, vcaClipAtt, humAtt, crossAtt;
     std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> analogEnvAtt, legatoAtt; // NEW attachments
-    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> lfoToggleAttachment, noiseToggleAttachment, driveToggleAttachment, delayToggleAttachment, consoleToggleAttachment, delaySyncAttachment, reverbToggleAttachment, lfoSyncAttachment, lfoToPitchAttachment, lfoToCutoffAttachment, lfoToAmpAttachment;
+    std::unique_ptr<juce::AudioProcessorValueTreeState::ButtonAttachment> lfoToggleAttachment, noiseToggleAttachment, driveToggleAttachment, delayToggleAttachment, consoleToggleAttachment, delaySyncAttachment, delayPingPongAttachment, reverbToggleAttachment, chorusToggleAttachment, lfoSyncAttachment, lfoToPitchAttachment, lfoToCutoffAttachment, lfoToAmpAttachment;
     
     // ===== Sound enhancement attachments ===============================
     std::unique_ptr<juce::AudioProcessorValueTreeState::ComboBoxAttachment>
@@ -173,5 +213,9 @@ private:
     juce::Label        tempoLabel;
     std::vector<double> tapTimes;         // timestamps for tap-tempo
 
+    // Convolution reverb impulse response
+    juce::TextButton   irLoadButton{"Load IR"};
+    std::unique_ptr<juce::FileChooser> irChooser;
+
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(AllSynthPluginAudioProcessorEditor)
 }; 
\ No newline at end of file
@@ -16,14 +16,66 @@ AllSynthPluginAudioProcessor::AllSynthPluginAudioProcessor()
       parameters(*this, nullptr, juce::Identifier("AllSynthParams"), createParameterLayout()),
       ccParamMap()
 {
-    // Create voices and sound
+    // Create voices and sound (all voices read one shared parameter snapshot)
+    voiceParams.attach(parameters);
+    voiceParams.update();
+
     const int numVoices = 8;
     for (int i = 0; i < numVoices; ++i)
-        synth.addVoice(new SynthVoice(parameters));
+        synth.addVoice(new SynthVoice(voiceParams));
 
     synth.addSound(new SynthSound());
     
     setupMidiCCMapping();   // NEW: build CC → parameter map
+
+    // --- cache parameter pointers -------------------------------------------
+    // Once, here: prepareToPlay already reads some of them
+    driveOnParam   = parameters.getRawParameterValue("DRIVE_ON");
+    driveAmtParam  = parameters.getRawParameterValue("DRIVE_AMT");
+    fatOnParam     = parameters.getRawParameterValue("CONSOLE_ON");
+    fatModeParam   = parameters.getRawParameterValue("CONSOLE_MODEL");
+    delayOnParam   = parameters.getRawParameterValue("DELAY_ON");
+    delaySyncDivParam = parameters.getRawParameterValue("DELAY_SYNC_DIV");
+    reverbOnParam  = parameters.getRawParameterValue("REVERB_ON");
+    reverbTypeParam= parameters.getRawParameterValue("REVERB_TYPE");
+    reverbSizeParam= parameters.getRawParameterValue("REVERB_SIZE");   // NEW
+    reverbAlgoParam= parameters.getRawParameterValue("REVERB_ALGO");
+    reverbRateParam= parameters.getRawParameterValue("REVERB_RATE");
+    fxRoutingParam = parameters.getRawParameterValue("FX_ROUTING");
+    chorusOnParam   = parameters.getRawParameterValue("CHORUS_ON");
+    chorusModeParam = parameters.getRawParameterValue("CHORUS_MODE");
+    chorusMixParam  = parameters.getRawParameterValue("CHORUS_MIX");
+    humOnParam     = parameters.getRawParameterValue("HUM_ON");
+    crossOnParam   = parameters.getRawParameterValue("CROSS_ON");
+    masterGainParam = parameters.getRawParameterValue("MASTER_GAIN");
+    // -------------------------------------------------------------------------
+
+    // -------- delay / reverb cached pointers (perf) -------------------------
+    delayMixParam    = parameters.getRawParameterValue("DELAY_MIX");
+    delayFbParam     = parameters.getRawParameterValue("DELAY_FB");
+    delayTimeParam   = parameters.getRawParameterValue("DELAY_TIME");
+    delaySyncParam   = parameters.getRawParameterValue("DELAY_SYNC");
+    delayPingPongParam = parameters.getRawParameterValue("DELAY_PINGPONG");
+    delayCrossParam    = parameters.getRawParameterValue("DELAY_CROSS");
+    delayTypeParam     = parameters.getRawParameterValue("DELAY_TYPE");
+    delayTapsParam     = parameters.getRawParameterValue("DELAY_TAPS");
+    reverbMixParam   = parameters.getRawParameterValue("REVERB_MIX");
+    
+    // --- cache enhancement toggle pointers -----------------------------------
+    enhOsParam     = parameters.getRawParameterValue("ENH_OS");
+    enhVcaParam    = parameters.getRawParameterValue("ENH_VCA");
+    enhDitherParam = parameters.getRawParameterValue("ENH_DITHER");
+
+    // --- voice placement / mono / quality --------------------------------------
+    voicePanModeParam = parameters.getRawParameterValue("VOICE_PAN_MODE");
+    voiceSpreadParam  = parameters.getRawParameterValue("VOICE_SPREAD");
+    monoModeParam     = parameters.getRawParameterValue("MONO_MODE");
+    glideParam        = parameters.getRawParameterValue("GLIDE");
+
+    qualityParam   = parameters.getRawParameterValue("QUALITY");
+    filterOsParam  = parameters.getRawParameterValue("FILTER_OS");
+
+    startTimerHz(20);       // delay memory housekeeping
 }
 
 //==============================================================================
@@ -114,6 +166,9 @@ juce::AudioProcessorValueTreeState::ParameterLayout AllSynthPluginAudioProcessor
         juce::StringArray{"1/1","1/2","1/4","1/8","1/16","1/4.","1/8."},
         2)); // default: 1/4
 
+    // LFO tempo sync on/off (the editor's sync toggle)
+    params.push_back(std::make_unique<juce::AudioParameterBool>("LFO_SYNC", "LFO Sync", false));
+
     // LFO phase offset (0..1)
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "LFO_PHASE", "LFO Phase",
@@ -153,6 +208,17 @@ juce::AudioProcessorValueTreeState::ParameterLayout AllSynthPluginAudioProcessor
         "DELAY_SYNC_DIV", "Delay Sync Div",
         juce::StringArray{"1/1","1/2","1/4","1/8","1/16","1/4.","1/8."},
         2));
+    params.push_back(std::make_unique<juce::AudioParameterBool>   ("DELAY_PINGPONG", "Delay Ping-Pong", false));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>  ("DELAY_CROSS",  "Delay Cross-FB",
+                                     juce::NormalisableRange<float>(0.0f,1.0f,0.001f), 0.0f));
+    params.push_back(std::make_unique<juce::AudioParameterChoice> (
+        "DELAY_TYPE", "Delay Type",
+        juce::StringArray{"Digital","Tape","BBD","Multi-Tap"},
+        0));
+    params.push_back(std::make_unique<juce::AudioParameterChoice> (
+        "DELAY_TAPS", "Delay Taps",
+        juce::StringArray{"Quarters","Dotted","Triplets","Golden","Cascade"},
+        0));
     params.push_back(std::make_unique<juce::AudioParameterBool>   ("REVERB_ON",    "Reverb On", false));
     params.push_back(std::make_unique<juce::AudioParameterFloat>  ("REVERB_MIX",   "Reverb Mix",
                                      juce::NormalisableRange<float>(0.0f,1.0f,0.001f), 0.3f));
@@ -163,6 +229,30 @@ juce::AudioProcessorValueTreeState::ParameterLayout AllSynthPluginAudioProcessor
         juce::StringArray{ "Classic", "Hall", "Plate", "Shimmer",
                           "Spring", "Room", "Cathedral", "Gated" }, 0));
 
+    // Reverb engine: JUCE's Freeverb or the feedback-delay network
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "REVERB_ALGO", "Reverb Algorithm",
+        juce::StringArray{ "Freeverb", "FDN", "Convolution" }, 0));
+
+    // Reverb tank rate: Freeverb/FDN at full, half or quarter session rate
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "REVERB_RATE", "Reverb Rate",
+        juce::StringArray{ "Full", "Half", "Quarter" }, 0));
+
+    // FX routing: delay -> reverb inserts, or parallel send/return buses
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "FX_ROUTING", "FX Routing",
+        juce::StringArray{ "Insert", "Send", "Send Mono" }, 0));
+
+    // BBD chorus / ensemble ahead of delay and reverb
+    params.push_back(std::make_unique<juce::AudioParameterBool>("CHORUS_ON", "Chorus On", false));
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "CHORUS_MODE", "Chorus Mode",
+        juce::StringArray{ "Juno I", "Juno II", "Juno I+II", "Ensemble" }, 0));
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "CHORUS_MIX", "Chorus Mix",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f), 0.5f));
+
     // === NEW : global size scale (0.1 … 2.0, default 1.0) =========
     params.push_back(std::make_unique<juce::AudioParameterFloat>(
         "REVERB_SIZE", "Reverb Size",
@@ -225,7 +315,7 @@ juce::AudioProcessorValueTreeState::ParameterLayout AllSynthPluginAudioProcessor
     // -------- New : Filter Oversampling --------------------------------
     params.push_back(std::make_unique<juce::AudioParameterChoice>(
         "FILTER_OS", "Filter Oversampling",
-        juce::StringArray{ "Off", "2× IIR", "4× IIR", "2× FIR Equiripple", "4× FIR Equiripple" },
+        juce::StringArray{ "Off", "2× IIR", "4× IIR", "2× FIR Equiripple", "4× FIR Equiripple", "Auto" },
         0));
     // ----------------------------------------------------------------
 
@@ -240,6 +330,33 @@ juce::AudioProcessorValueTreeState::ParameterLayout AllSynthPluginAudioProcessor
         "ENH_DITHER",  "Dither On",               false));
     // ------------------------------------------------------------------------
 
+    // -------- Voice stereo placement -----------------------------------------
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "VOICE_PAN_MODE", "Voice Pan",
+        juce::StringArray{ "Off", "Alternate", "Random", "Note" },
+        0));  // default = Off (all voices centred, as before)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "VOICE_SPREAD", "Voice Spread",
+        juce::NormalisableRange<float>(0.0f, 1.0f, 0.001f), 0.5f));
+    // ------------------------------------------------------------------------
+
+    // -------- Mono engine: note priority + glide -----------------------------
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "MONO_MODE", "Mono Mode",
+        juce::StringArray{ "Off", "Last", "Low", "High" },
+        0));  // default = Off (polyphonic)
+    params.push_back(std::make_unique<juce::AudioParameterFloat>(
+        "GLIDE", "Glide",
+        juce::NormalisableRange<float>(0.0f, 2.0f, 0.001f, 0.4f), 0.0f));   // seconds
+    // ------------------------------------------------------------------------
+
+    // -------- Quality tier (see QualityModes.h) ------------------------------
+    params.push_back(std::make_unique<juce::AudioParameterChoice>(
+        "QUALITY", "Quality",
+        juce::StringArray{ "Custom", "Eco", "Standard", "HQ" },
+        0));  // default = Custom (individual controls)
+    // ------------------------------------------------------------------------
+
     return { params.begin(), params.end() };
 }
 
@@ -247,28 +364,74 @@ juce::AudioProcessorValueTreeState::ParameterLayout AllSynthPluginAudioProcessor
 void AllSynthPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesPerBlock)
 {
     synth.setCurrentPlaybackSampleRate(sampleRate);
+    preparedBlockSize = samplesPerBlock;
+
+    // One aligned arena for voice state, voice scratch and the voice bus: sized here,
+    // carved up by the prepare calls below.
+    // Voices only ever see engine micro-blocks, so their scratch is tiny and
+    // independent of the host block size.
+    arena.allocate(SynthVoice::hotStateFloats(synth.getNumVoices())
+                   + size_t(synth.getNumVoices()) * SynthVoice::arenaFloats(SynthEngine::maxMicroBlock)
+                   + SynthEngine::arenaFloats());
+
+    // the voices' per-sample state first, as one contiguous array
+    auto* hotStates = SynthVoice::createHotStates(arena, synth.getNumVoices());
 
     for (int i = 0; i < synth.getNumVoices(); ++i)
         if (auto* v = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-            v->prepare(sampleRate, samplesPerBlock, getTotalNumOutputChannels());
+            v->prepare(sampleRate, SynthEngine::maxMicroBlock, getTotalNumOutputChannels(), arena,
+                       hotStates[i], i);
+    synth.prepare(arena);
+    synth.setMicroBlockSize(microBlockSize);
 
     // NEW FX -------------------------------------------------------------------
-    const int maxDelay = int(sampleRate * 5.0);  // 5‑second max
-    delayL.prepare(sampleRate, maxDelay);
-    delayR.prepare(sampleRate, maxDelay);
-
-    // Allocate delay scratch buffers once
-    delayTmpL.setSize(1, samplesPerBlock);
-    delayTmpR.setSize(1, samplesPerBlock);
+    // Sized for the longest reachable time; the memory itself only exists
+    // while the delay is in use (DelayLine::serviceMemory, from timerCallback).
+    // Offline the message thread may barely run, so a bounce gets it up front.
+    delay.prepare(sampleRate, int(std::ceil(sampleRate * delayMaxSeconds)),
+                  delayOnParam->load() > 0.5f || isNonRealtime());
+    delayBypassSamples = 0;
+
+    chorus.prepare(sampleRate);
+
+    chorusGate.wake();
+    delayGate.wake();
+    reverbGate.wake();
+    outputGate.wake();
+    chorusGate.setHoldSamples(juce::int64(ChorusEnsemble::getTailSeconds() * sampleRate) + 1);
+    reverbGate.setHoldSamples(juce::int64(reverbHoldSeconds * sampleRate));
+    outputGate.setHoldSamples(juce::int64(outputHoldSeconds * sampleRate));
 
     juce::dsp::ProcessSpec spec { sampleRate,
                                   static_cast<uint32>(samplesPerBlock),
                                   static_cast<uint32>(getTotalNumOutputChannels()) };
     reverb.prepare(spec);
+    if (isNonRealtime())
+        reverb.allocateFdnNow();
+
+    // Send/return buses (FX_ROUTING = Send)
+    delaySend .setSize(2, samplesPerBlock);
+    reverbSend.setSize(2, samplesPerBlock);
     
-    // Drive oversampling
-    driveOS.reset();
-    driveOS.initProcessing(static_cast<uint32>(samplesPerBlock));
+    // Drive oversampling: every variant up front, applyQuality below picks one
+    for (size_t stages = 1; stages <= 2; ++stages)
+        for (auto kernel : { HalfBandResampler::Kernel::minimumPhase, HalfBandResampler::Kernel::linearPhase })
+        {
+            auto& os = driveOsVariants[(stages - 1) * 2 + (size_t) kernel];
+            os = std::make_unique<HalfBandResampler>(2, stages, kernel);
+            os->initProcessing(static_cast<size_t>(samplesPerBlock));
+        }
+    driveOS = nullptr;
+    driveBypassDelay.prepare(spec);
+
+    // HQ runs the slowest kernels any tier or FILTER_OS choice can (4× FIR
+    // voices + 4× FIR drive, both two linear-phase stages); everything else
+    // is padded up to it
+    const float fir4x = driveOsVariants[2 + (size_t) HalfBandResampler::Kernel::linearPhase]->getLatencyInSamples();
+    hqLatency = (int) std::ceil(2.0f * fir4x);
+    latencyPad.prepare(spec);
+
+    chunkMidi.ensureSize(4096);
     
     // Reset AnalogueDrive filter states
     anaDriveL.reset();
@@ -290,37 +453,83 @@ void AllSynthPluginAudioProcessor::prepareToPlay(double sampleRate, int samplesP
     
     fatChain.get<4>().functionToUse = [](float x) { return x; }; // sat (index is now 4)
     fatChain.get<5>().setGainLinear(1.0f);          // post (index is now 5)
+    consoleShaperTables();                          // built here, not mid-block
+    previousFatMode = -1;                           // re-voice the fresh chain on first use
     
-    // --- cache parameter pointers -------------------------------------------
-    driveOnParam   = parameters.getRawParameterValue("DRIVE_ON");
-    driveAmtParam  = parameters.getRawParameterValue("DRIVE_AMT");
-    fatOnParam     = parameters.getRawParameterValue("CONSOLE_ON");
-    fatModeParam   = parameters.getRawParameterValue("CONSOLE_MODEL");
-    delayOnParam   = parameters.getRawParameterValue("DELAY_ON");
-    delaySyncDivParam = parameters.getRawParameterValue("DELAY_SYNC_DIV");
-    reverbOnParam  = parameters.getRawParameterValue("REVERB_ON");
-    reverbTypeParam= parameters.getRawParameterValue("REVERB_TYPE");
-    reverbSizeParam= parameters.getRawParameterValue("REVERB_SIZE");   // NEW
-    humOnParam     = parameters.getRawParameterValue("HUM_ON");
-    crossOnParam   = parameters.getRawParameterValue("CROSS_ON");
-    masterGainParam = parameters.getRawParameterValue("MASTER_GAIN");
-    // -------------------------------------------------------------------------
+    // --- quality tier: rebuild everything for the new block size -------------
+    qualityValid   = false;
+    applyQuality(resolveQuality());
 
-    // -------- delay / reverb cached pointers (perf) -------------------------
-    delayMixParam    = parameters.getRawParameterValue("DELAY_MIX");
-    delayFbParam     = parameters.getRawParameterValue("DELAY_FB");
-    delayTimeParam   = parameters.getRawParameterValue("DELAY_TIME");
-    delaySyncParam   = parameters.getRawParameterValue("DELAY_SYNC");
-    reverbMixParam   = parameters.getRawParameterValue("REVERB_MIX");
-    
-    // --- cache enhancement toggle pointers -----------------------------------
-    enhOsParam     = parameters.getRawParameterValue("ENH_OS");
-    enhVcaParam    = parameters.getRawParameterValue("ENH_VCA");
-    enhDitherParam = parameters.getRawParameterValue("ENH_DITHER");
+    // not running yet: tell the host directly
+    cancelPendingUpdate();
+    setLatencySamples(engineLatency.load());
 }
 
 void AllSynthPluginAudioProcessor::releaseResources() {}
 
+void AllSynthPluginAudioProcessor::fillSendBus(juce::AudioBuffer<float>& bus,
+                                               const juce::AudioBuffer<float>& source,
+                                               float level, bool monoSum) noexcept
+{
+    const int numSamples  = source.getNumSamples();
+    const int numChannels = juce::jmin(2, source.getNumChannels());
+    jassert(numSamples <= preparedBlockSize);                   // processBlock splits larger blocks
+    bus.setSize(numChannels, numSamples, false, false, true);   // sized in prepareToPlay, never grows
+
+    if (monoSum && numChannels > 1)
+    {
+        bus.copyFrom(0, 0, source.getReadPointer(0), numSamples, 0.5f * level);
+        bus.addFrom (0, 0, source, 1, 0, numSamples, 0.5f * level);
+        bus.copyFrom(1, 0, bus, 0, 0, numSamples);
+        return;
+    }
+
+    for (int ch = 0; ch < numChannels; ++ch)
+        bus.copyFrom(ch, 0, source.getReadPointer(ch), numSamples, level);
+}
+
+bool AllSynthPluginAudioProcessor::loadImpulseResponse(const juce::File& wavFile)
+{
+    return reverb.loadImpulseResponse(wavFile);
+}
+
+void AllSynthPluginAudioProcessor::timerCallback()
+{
+    // Delay and FDN memory and replaced IRs are built and freed here, never
+    // on the audio thread
+    delay.serviceMemory();
+    reverb.service();
+}
+
+void AllSynthPluginAudioProcessor::setNonRealtime(bool isNonRealtime) noexcept
+{
+    AudioProcessor::setNonRealtime(isNonRealtime);
+
+    // No deadline while bouncing: spread the voices over every core.
+    synth.setParallelRendering(isNonRealtime);
+
+    // The delay's and the FDN's memory normally wait for timerCallback,
+    // which may not run during a bounce; build them now so automation that
+    // enables them renders the same every time (HQ also moves Freeverb
+    // patches onto the FDN)
+    if (isNonRealtime && preparedBlockSize > 0)
+    {
+        const juce::ScopedLock sl(getCallbackLock());
+        if (! delay.hasMemory())
+            delay.prepare(getSampleRate(), int(std::ceil(getSampleRate() * delayMaxSeconds)), true);
+        reverb.allocateFdnNow();
+    }
+
+    // Switch tier here rather than on the next block, so the rebuild happens
+    // before the bounce starts. resolveQuality() maps offline to HQ and back
+    // to the live tier; the reported latency is the same in both.
+    if (preparedBlockSize > 0)
+    {
+        const juce::ScopedLock sl(getCallbackLock());
+        applyQuality(resolveQuality());
+    }
+}
+
 #ifndef JucePlugin_PreferredChannelConfigurations
 bool AllSynthPluginAudioProcessor::isBusesLayoutSupported(const BusesLayout& layouts) const
 {
@@ -344,8 +553,32 @@ bool AllSynthPluginAudioProcessor::isBusesLayoutSupported(const BusesLayout& lay
 
 //==============================================================================
 void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
+{
+    const int numSamples = buffer.getNumSamples();
+    if (numSamples <= preparedBlockSize || preparedBlockSize <= 0)
+    {
+        renderBlock(buffer, midiMessages);
+        return;
+    }
+
+    // The host sent more than it announced: render in prepared-size chunks.
+    // The chunk buffer only refers to the host's channels, so nothing here
+    // allocates (chunkMidi was reserved in prepareToPlay).
+    for (int start = 0; start < numSamples; start += preparedBlockSize)
+    {
+        const int n = juce::jmin(preparedBlockSize, numSamples - start);
+        juce::AudioBuffer<float> chunk(buffer.getArrayOfWritePointers(), buffer.getNumChannels(), start, n);
+
+        chunkMidi.clear();
+        chunkMidi.addEvents(midiMessages, start, n, -start);
+        renderBlock(chunk, chunkMidi);
+    }
+}
+
+void AllSynthPluginAudioProcessor::renderBlock(juce::AudioBuffer<float>& buffer, juce::MidiBuffer& midiMessages)
 {
     juce::ScopedNoDenormals noDenormals;
+    const auto blockStartTicks = juce::Time::getHighResolutionTicks();   // CPU watchdog
     
     // NEW: respond to MIDI‑CC messages -----------------------------------------
     for (const auto metadata : midiMessages)
@@ -355,25 +588,11 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
     
     buffer.clear();
 
-    // ---------- Oversampling change detection ------------------------------
+    // ---------- Quality / oversampling change detection ---------------------
     {
-        // base user choice
-        int desiredOs = int(*parameters.getRawParameterValue("FILTER_OS"));
-        
-        // if ENH_OS is non-zero, force that oversampling mode
-        if (enhOsParam)
-        {
-            int enhChoice = int(*enhOsParam); // 0…4
-            if (enhChoice > 0)
-                desiredOs = enhChoice;
-        }
-        if (desiredOs != lastFilterOs)
-        {
-            lastFilterOs = desiredOs;
-            for (int i = 0; i < synth.getNumVoices(); ++i)
-                if (auto* v = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
-                    v->updateOversampling(); // one-time rebuild per voice
-        }
+        const auto wanted = resolveQuality();
+        if (wanted != activeQuality)
+            applyQuality(wanted);   // one-time rebuild per change
     }
 
     // ---------- Transport info (single query) -------------------------------
@@ -388,6 +607,15 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
         if (auto* v = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
             v->setHostBpm(hostBpm);
 
+    // One parameter snapshot for every voice in this block
+    voiceParams.update();
+
+    // Stereo placement applies to notes started in this block
+    synth.setVoicePlacement(voicePanModeParam ? int(voicePanModeParam->load()) : 0,
+                            voiceSpreadParam  ? voiceSpreadParam->load()       : 0.5f);
+    synth.setMonoMode(monoModeParam ? int(monoModeParam->load()) : 0,
+                      glideParam    ? glideParam->load()         : 0.0f);
+
     synth.renderNextBlock(buffer, midiMessages, 0, buffer.getNumSamples());
 
     // === Analogue Extras: Hum + Crosstalk ====================================
@@ -421,11 +649,75 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
 
     // ----------------------  GLOBAL FX  --------------------------------------
     const bool  delayOn   = *delayOnParam > 0.5f;
+    const bool  revOn     = *reverbOnParam > 0.5f;
+    const bool  chorusOn  = chorusOnParam && *chorusOnParam > 0.5f;
     const bool  syncOn    = (delaySyncParam && *delaySyncParam > 0.5f);
 
+    // A long-bypassed delay hands its memory back, idle or not
+    if (delayOn)
+        delayBypassSamples = 0;
+    else if (delay.hasMemory() && ! isNonRealtime()     // a bounce keeps it (see setNonRealtime)
+             && (delayBypassSamples += buffer.getNumSamples()) > delayReleaseSeconds * getSampleRate())
+        delay.releaseMemory();
+
+    // ---------- Idle fast path ----------------------------------------------
+    // No voice, no hum and every tail died away: the block is silence, so
+    // skip the FX, drive oversampling and console chain altogether.
+    bool silent = TailGate::isSilent(buffer);
+    if (silent
+        && (! chorusOn || chorusGate.isIdle())
+        && (! delayOn || delayGate.isIdle())
+        && (! revOn   || reverbGate.isIdle())
+        && outputGate.isIdle())
+    {
+        buffer.clear();
+        return;
+    }
+
+    // ----- Chorus / ensemble: on the mix, so the FX sends carry it ------------
+    if (chorusOn)
+    {
+        chorus.setMode(static_cast<ChorusEnsemble::Mode>(int(chorusModeParam->load())));
+        chorus.setMix(chorusMixParam->load());
+
+        if (chorusGate.shouldProcess(silent))
+        {
+            chorus.process(buffer.getWritePointer(0),
+                           buffer.getNumChannels() > 1 ? buffer.getWritePointer(1) : nullptr,
+                           buffer.getNumSamples());
+
+            const bool inputSilent = silent;
+            silent = TailGate::isSilent(buffer);
+            if (chorusGate.update(inputSilent, silent, buffer.getNumSamples()))
+                chorus.reset();
+        }
+    }
+    else
+    {
+        chorusGate.wake();
+    }
+
     const float delayMix  = delayMixParam  ? delayMixParam ->load() : 0.0f;
     const float fb        = delayFbParam   ? delayFbParam  ->load() : 0.0f;
     const float timeMsPar = delayTimeParam ? delayTimeParam->load() : 500.0f;
+    const float revMix    = reverbMixParam ? reverbMixParam->load() : 0.3f;
+
+    // ---------- FX routing ---------------------------------------------------
+    // Insert: delay then reverb in place on the mix, DELAY_MIX / REVERB_MIX
+    // as dry/wet. Send: the mixes become send levels, each FX runs wet-only
+    // on its own bus (stereo or mono-summed) and the returns are summed onto
+    // the dry signal after both.
+    const int  fxRouting = fxRoutingParam ? int(fxRoutingParam->load()) : 0;
+    const bool sendMode  = fxRouting != 0;
+    const bool monoSend  = fxRouting == 2;
+    const int  numFxSamples = buffer.getNumSamples();
+
+    if (sendMode && delayOn) fillSendBus(delaySend,  buffer, delayMix, monoSend);
+    if (sendMode && revOn)   fillSendBus(reverbSend, buffer, revMix,   monoSend);
+
+    auto& delayBus  = sendMode ? delaySend  : buffer;
+    auto& reverbBus = sendMode ? reverbSend : buffer;
+    bool  delayReturned = false, reverbReturned = false;
 
     // ---- calc (possibly BPM‑synced) delay time ------------------------------
     double delaySeconds = timeMsPar * 0.001;
@@ -433,36 +725,53 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
     {
         static const std::array<double,7> divFactors { 1.0,2.0,4.0,8.0,16.0,1.5,3.0 };
         int idx = juce::jlimit (0, 6, int (delaySyncDivParam->load()));
-        delaySeconds = (60.0 / hostBpm) / divFactors[idx];
+        delaySeconds = (60.0 / juce::jmax(delaySyncMinBpm, hostBpm)) / divFactors[idx];
     }
 
-    // process L & R separately
-    if (delayOn)
+    // stereo, in place on its bus. Until the message thread has built the
+    // rings (first enable) the delay passes the signal dry (no return).
+    delayGate.setHoldSamples(juce::int64((delaySeconds + delayHoldMarginSeconds) * getSampleRate()));
+
+    if (delayOn && delay.acquireMemory())
     {
-        if (delayMix != prevDelayMix)      { delayL.setMix(delayMix); delayR.setMix(delayMix); prevDelayMix = delayMix; }
-        if (fb        != prevDelayFb)       { delayL.setFeedback(fb);  delayR.setFeedback(fb);  prevDelayFb  = fb; }
+        const float delayWet = sendMode ? 1.0f : delayMix;    // a send returns wet only
+        if (delayWet != prevDelayMix)      { delay.setMix(delayWet); prevDelayMix = delayWet; }
+        if (fb        != prevDelayFb)       { delay.setFeedback(fb);  prevDelayFb  = fb; }
         if (delaySeconds != prevDelaySeconds)
         {
-            delayL.setDelayTime ((float) delaySeconds);
-            delayR.setDelayTime ((float) delaySeconds);
+            delay.setDelayTime ((float) delaySeconds);
             prevDelaySeconds = (float) delaySeconds;
         }
+        delay.setPingPong (delayPingPongParam && *delayPingPongParam > 0.5f);
+        delay.setCrossFeedback (delayCrossParam ? delayCrossParam->load() : 0.0f);
 
-        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        const int delayType = delayTypeParam ? int (delayTypeParam->load()) : 0;
+        if (delayType != prevDelayType)
         {
-            auto& mono = (ch == 0 ? delayTmpL : delayTmpR);
-            mono.setSize(1, buffer.getNumSamples(), false, false, true);
-            mono.copyFrom(0, 0, buffer, ch, 0, buffer.getNumSamples());
+            delay.setType ((DelayLine::DelayType) delayType);
+            prevDelayType = delayType;
+        }
+        delay.setTapPattern (delayTapsParam ? int (delayTapsParam->load()) : 0);
 
-            (ch == 0 ? delayL : delayR).processBlock(mono);    // digital flavour
-            buffer.copyFrom(ch, 0, mono, 0, 0, buffer.getNumSamples());
+        const bool inputSilent = sendMode ? TailGate::isSilent(delayBus) : silent;
+        if (delayGate.shouldProcess(inputSilent))
+        {
+            delay.processBlock(delayBus);  // both channels in place
+
+            const bool outputSilent = TailGate::isSilent(delayBus);
+            if (delayGate.update(inputSilent, outputSilent, numFxSamples))
+                delay.reset();             // drop the sub-threshold residue once
+            if (! sendMode)
+                silent = outputSilent;
+            delayReturned = sendMode;
         }
     }
+    else if (! delayOn)
+    {
+        delayGate.wake();
+    }
 
     // ----- Reverb ------------------------------------------------------------
-    const bool  revOn  = *reverbOnParam > 0.5f;
-    const float revMix = reverbMixParam ? reverbMixParam->load() : 0.3f;
-
     // === NEW : choose and (re)‑configure the reverb when the user changes type
     const int  revType = static_cast<int>(*reverbTypeParam);
     const float sizeScale = juce::jlimit(0.1f, 2.0f, reverbSizeParam->load());   // NEW
@@ -519,6 +828,7 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
         p.roomSize = juce::jlimit(0.0f, 1.0f, p.roomSize * sizeScale);
         
         reverb.setParameters(p);
+        reverb.setFdnSettings(FdnReverb::presetFor(revType, sizeScale));
         previousReverbType = revType;
         previousSizeScale = sizeScale;  // NEW
     }
@@ -526,8 +836,57 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
     if (revOn)
     {
         if (revMix != prevReverbMix) { reverb.setMix(revMix); prevReverbMix = revMix; }
-        reverb.processBlock(buffer);
+        // HQ moves Freeverb patches onto the FDN; an IR is always kept
+        const int algo = int(reverbAlgoParam->load());
+        const bool tierAlgo = activeQuality.reverbAlgo >= 0
+                           && algo != int(ReverbProcessor::Algorithm::Convolution);
+        reverb.setAlgorithm(static_cast<ReverbProcessor::Algorithm>(tierAlgo ? activeQuality.reverbAlgo : algo));
+        reverb.setRateDivider(activeQuality.reverbDivider > 0 ? activeQuality.reverbDivider   // tier-forced
+                                                              : 1 << int(reverbRateParam->load()));
+
+        const bool inputSilent = sendMode ? TailGate::isSilent(reverbBus) : silent;
+        if (reverbGate.shouldProcess(inputSilent))
+        {
+            if (sendMode) reverb.processWet(reverbBus);
+            else          reverb.processBlock(reverbBus);
+
+            const bool outputSilent = TailGate::isSilent(reverbBus);
+            if (reverbGate.update(inputSilent, outputSilent, numFxSamples))
+                reverb.reset();
+            if (! sendMode)
+                silent = outputSilent;
+            reverbReturned = sendMode;
+        }
+    }
+    else
+    {
+        reverbGate.wake();
     }
+
+    // ----- Returns -------------------------------------------------------------
+    if (sendMode)
+    {
+        for (int ch = 0; ch < buffer.getNumChannels(); ++ch)
+        {
+            if (delayReturned)  buffer.addFrom(ch, 0, delaySend,  juce::jmin(ch, delaySend.getNumChannels() - 1),  0, numFxSamples);
+            if (reverbReturned) buffer.addFrom(ch, 0, reverbSend, juce::jmin(ch, reverbSend.getNumChannels() - 1), 0, numFxSamples);
+        }
+        silent = TailGate::isSilent(buffer);
+    }
+
+    // In series the reverb also carries the delay's tail; in parallel the
+    // longer of the two sets it
+    {
+        const double delayTail  = delayOn ? delay.getTailSeconds()  : 0.0;
+        const double reverbTail = revOn   ? reverb.getTailSeconds() : 0.0;
+        const double chorusTail = chorusOn ? ChorusEnsemble::getTailSeconds() : 0.0;
+        tailSeconds.store(chorusTail + (sendMode ? juce::jmax(delayTail, reverbTail) : delayTail + reverbTail));
+    }
+
+    // drive and console have short memories of their own; the fast path
+    // waits for them too
+    const bool postInputSilent = silent;
+    outputGate.shouldProcess(postInputSilent);
     
     // ----- High-Quality Drive ---------------------------------------------------
     driveOn  = *driveOnParam > 0.5f;
@@ -553,7 +912,7 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
 
         // Oversample -> process -> downsample
         auto block = juce::dsp::AudioBlock<float>(buffer);
-        auto osBlock = driveOS.processSamplesUp(block);
+        auto osBlock = driveOS->processSamplesUp(block);
 
         // Process each sample with the corresponding AnalogueDrive instance
         for (int ch = 0; ch < (int)osBlock.getNumChannels(); ++ch)
@@ -567,7 +926,20 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
             }
         }
 
-        driveOS.processSamplesDown(block); // back to normal rate
+        driveOS->processSamplesDown(block); // back to normal rate
+    }
+    else
+    {
+        // Bypassed drive still costs its latency, so toggling it never
+        // shifts the signal against what the host compensates for
+        juce::dsp::AudioBlock<float> block(buffer);
+        driveBypassDelay.process(juce::dsp::ProcessContextReplacing<float>(block));
+    }
+
+    // Make up the difference to HQ's latency (see applyQuality)
+    {
+        juce::dsp::AudioBlock<float> block(buffer);
+        latencyPad.process(juce::dsp::ProcessContextReplacing<float>(block));
     }
     // -------------------------------------------------------------------------
 
@@ -577,345 +949,22 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
 
     if (fatOn)
     {
-        auto& pre   = fatChain.get<0>();
-        auto& tone1 = fatChain.get<1>();
-        auto& tone2 = fatChain.get<2>();
-        auto& comp  = fatChain.get<3>();
-        auto& sat   = fatChain.get<4>();
-        auto& post  = fatChain.get<5>();
-        const double sr = getSampleRate(); // Get sample rate once
-
         // Only rebuild the chain if the mode has changed
-        if (fatMode != previousFatMode) 
+        if (fatMode != previousFatMode)
         {
             previousFatMode = fatMode;
-            
-            // --- Reset bypass states before setting for current mode ---
-            fatChain.setBypassed<1>(false); // Assume tone1 is used unless bypassed below
-            fatChain.setBypassed<2>(true);  // Assume tone2 is NOT used unless enabled below
-            fatChain.setBypassed<3>(true);  // Assume comp is NOT used unless enabled below
+            configureConsole(fatChain, fatMode, getSampleRate());
+            consoleSaturator   = fatChain.get<4>().functionToUse;
+            consoleTablePoints = -1;
+        }
 
-            switch (fatMode)
-            {
-                case 0:   // ───── Tape Thick ──────────────────────────────────────
-                    pre.setGainLinear(1.20f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeLowShelf(sr, 200.f, 0.7f, 1.5f);
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x)
-                    {
-                        return 0.6f * x + 0.4f * std::tanh(1.8f * x);
-                    };
-                    post.setGainLinear(0.83f);
-                    break;
-
-                case 1:   // ───── Warm Tube ──────────────────────────────────────
-                    pre.setGainLinear(1.30f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeLowPass(sr, 14000.f);   // soft HF
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x)
-                    {
-                        return 0.4f * x + 0.6f * std::tanh(2.5f * x);  // richer
-                    };
-                    post.setGainLinear(0.80f);
-                    break;
-
-                case 2:   // ───── Deep Console ───────────────────────────────────
-                    pre.setGainLinear(1.25f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeHighShelf(sr, 6000.f, 0.8f, 0.9f); // tiny HF dip
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setThreshold(-12.f);
-                    comp.setRatio(2.0f);
-                    sat.functionToUse = [](float x)
-                    {
-                        return 0.55f * std::tanh(2.0f * x) + 0.45f * x;
-                    };
-                    post.setGainLinear(0.90f);
-                    break;
-
-                case 3:   // ───── Punch Glue ────────────────────────────────────
-                    pre.setGainLinear(1.10f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeHighShelf(sr, 5000.f, 0.8f, 1.25f);
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setThreshold(-18.f);
-                    comp.setRatio(4.0f);
-                    comp.setAttack(5.f);
-                    comp.setRelease(60.f);
-                    sat.functionToUse = [](float x)
-                    { return 0.5f * (x + std::tanh(2.2f * x)); };
-                    post.setGainLinear(1.00f);
-                    break;
-
-                case 4:   // ───── Sub Boom ──────────────────────────────────────
-                    pre.setGainLinear(1.15f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeLowShelf(sr, 80.f, 0.7f, 1.8f);
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x)
-                    { return 0.7f * x + 0.3f * juce::jlimit(-1.f, 1.f, x * x * x); };
-                    post.setGainLinear(0.80f);
-                    break;
-
-                case 5:   // ── Opto Smooth ──────────────────────────────────────
-                    pre.setGainLinear(1.12f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeHighShelf(sr, 7000.f, 0.7f, 1.10f);
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(3.0f);
-                    comp.setThreshold(-16.f);
-                    comp.setAttack(10.f); // Slower opto attack
-                    comp.setRelease(150.f); // Slower opto release
-                    sat.functionToUse = [](float x)
-                    {   return 0.5f * x + 0.5f * std::tanh(2.0f * x); };
-                    post.setGainLinear(0.92f);
-                    break;
-
-                case 6:   // ── Tube Crunch ──────────────────────────────────────
-                    pre.setGainLinear(1.40f);
-                    // Approximate tilt with a high shelf cut
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeHighShelf(sr, 1200.f, 0.7f, 0.8f); // Gentle high cut
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x)
-                    {   float y = std::tanh(3.5f * x);
-                        y = 0.6f * y + 0.4f * std::tanh(1.2f * y);     // two stage
-                        return y;
-                    };
-                    post.setGainLinear(0.78f);
-                    break;
-
-                case 7:   // ── X-Former Fat ─────────────────────────────────────
-                    pre.setGainLinear(1.25f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeLowShelf(sr, 110.f, 0.7f, 1.7f);
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x)
-                    {   return 0.55f * std::tanh(2.8f * x)
-                             + 0.45f * std::tanh(0.9f * x); }; // Blend two tanh stages
-                    post.setGainLinear(0.85f);
-                    break;
-
-                case 8:   // ── Bus Glue ──────────────────────────────────────────
-                    pre.setGainLinear(1.10f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeHighShelf(sr, 9000.f, 0.8f, 0.95f); // slight dip
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(1.8f);
-                    comp.setThreshold(-10.f);
-                    comp.setAttack(2.f);
-                    comp.setRelease(80.f);
-                    sat.functionToUse = [](float x)
-                    {   return 0.6f * x + 0.4f * std::tanh(1.6f * x); };
-                    post.setGainLinear(0.95f);
-                    break;
-
-                case 9:   // ── Vintage Tape ─────────────────────────────────────
-                    pre.setGainLinear(1.30f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>
-                                        ::makeLowPass(sr, 15000.f); // Tape HF roll-off
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(2.5f);
-                    comp.setThreshold(-15.f);
-                    comp.setAttack(5.f);
-                    comp.setRelease(60.f);
-                    sat.functionToUse = [](float x)
-                    {   // soft knee + HF head bump (simulated via blend)
-                        float core = std::tanh(2.2f * x);
-                        return 0.7f * core + 0.3f * x;
-                    };
-                    post.setGainLinear(0.85f);
-                    break;
-
-                // --- NEW 70s Gear Emulations (Cases 10-24) ---
-
-                case 10:   // ── Neve 1073 ────────────────────────────────────────
-                    pre.setGainLinear(1.25f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,  80.f, 0.7f, 1.6f); // Low shelf
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr, 12000.f,0.8f,1.15f); // High shelf
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x){ return 0.55f*x + 0.45f*std::tanh(2.8f*x); };
-                    post.setGainLinear(0.88f);
-                    break;
-
-                case 11:   // ── API 312 + 550A ───────────────────────────────────
-                    pre.setGainLinear(1.20f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,  50.f, 0.7f, 1.5f); // Low shelf
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sr, 3500.f,1.0f,1.25f); // Mid peak
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setThreshold(-14.f); comp.setRatio(3.f); comp.setAttack(1.f); comp.setRelease(50.f); // API comp settings
-                    sat.functionToUse = [](float x){ return 0.5f*x + 0.5f*std::tanh(3.2f*x); };
-                    post.setGainLinear(0.90f);
-                    break;
-
-                case 12:   // ── Helios 69 ────────────────────────────────────────
-                    pre.setGainLinear(1.15f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,10000.f,0.7f,1.25f); // High Shelf
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sr, 700.f,1.4f,0.8f); // Mid dip
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x){ return std::tanh(2.0f*x)*(1.0f-0.1f*x*x); }; // Triode-like
-                    post.setGainLinear(0.85f);
-                    break;
-
-                case 13:   // ── Studer A80 15 IPS ────────────────────────────────
-                    pre.setGainLinear(1.30f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr, 45.f,0.7f,1.8f); // Head bump
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr,15000.f); // HF roll-off
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setThreshold(-17.f); comp.setRatio(2.2f); comp.setAttack(5.f); comp.setRelease(60.f);
-                    sat.functionToUse = [](float x)
-                    {   float y = 0.6f*std::tanh(2.4f*x) + 0.4f*std::tanh(0.9f*x); // Two-stage tape sat
-                        return y; };
-                    post.setGainLinear(0.82f);
-                    break;
-
-                case 14:   // ── EMI TG-12345 ─────────────────────────────────────
-                    pre.setGainLinear(1.18f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sr, 30.f); // HPF
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr, 5000.f,0.8f,1.2f); // Presence
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setThreshold(-12.f); comp.setRatio(2.f); comp.setAttack(5.f); comp.setRelease(100.f); // TG comp
-                    sat.functionToUse = [](float x)
-                    {   return 0.5f*x + 0.5f*std::tanh(1.8f*x); };
-                    post.setGainLinear(0.90f);
-                    break;
-
-                case 15: // ── SSL 4K-Bus ─────────────────────────────────────────
-                    pre.setGainLinear(1.08f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 18500.f); // Slight HF roll-off
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(2.0f);  comp.setThreshold(-12.f);
-                    comp.setAttack(3.f);  comp.setRelease(100.f); // SSL Bus Comp settings
-                    sat.functionToUse = [](float x){ return 0.4f*x+0.6f*std::tanh(1.8f*x); };
-                    post.setGainLinear(0.93f);
-                    break;
-
-                case 16: // ── LA-2A ─────────────────────────────────────────────
-                    pre.setGainLinear(1.20f);
-                    // No significant EQ on LA-2A, use flat setting
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 22000.f);
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(3.5f);  comp.setThreshold(-14.f);
-                    comp.setAttack(10.f); comp.setRelease(200.f); // Slower opto release
-                    sat.functionToUse = [](float x){ return 0.5f*x+0.5f*std::tanh(2.3f*x); }; // Gentle tube sat
-                    post.setGainLinear(0.88f);
-                    break;
-
-                case 17: // ── Fairchild 670 ────────────────────────────────────
-                    pre.setGainLinear(1.25f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 16000.f); // Gentle HF roll-off
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(6.f);   comp.setThreshold(-10.f);
-                    comp.setAttack(0.8f); comp.setRelease(300.f); // Very slow release
-                    sat.functionToUse = [](float x){ return 0.45f*x+0.55f*std::tanh(3.f*x); }; // Rich tube sat
-                    post.setGainLinear(0.83f);
-                    break;
-
-                case 18: // ── Pultec EQP-1A ────────────────────────────────────
-                    pre.setGainLinear(1.15f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr, 30.f,0.7f,1.8f); // Low boost
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,5000.f,0.8f,1.2f); // High boost
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x){ return 0.65f*x+0.35f*std::tanh(1.6f*x); }; // Light saturation
-                    post.setGainLinear(0.85f);
-                    break;
-
-                case 19: // ── Quad-Eight ───────────────────────────────────────
-                    pre.setGainLinear(1.22f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,100.f,0.9f,1.6f); // Broad low boost
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x){ return 0.55f*std::tanh(2.4f*x)+0.45f*x; }; // Opamp/transformer sat
-                    post.setGainLinear(0.87f);
-                    break;
-
-                case 20: // ── Harrison 32 ──────────────────────────────────────
-                    pre.setGainLinear(1.10f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,8000.f,0.8f,1.15f); // Airy presence
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(1.7f);  comp.setThreshold(-11.f);
-                    comp.setAttack(2.f);  comp.setRelease(90.f); // Mix bus comp
-                    sat.functionToUse = [](float x){ return 0.5f*x+0.5f*std::tanh(1.7f*x); };
-                    post.setGainLinear(0.95f);
-                    break;
-
-                case 21: // ── MCI JH-636 ───────────────────────────────────────
-                    pre.setGainLinear(1.18f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,60.f,0.7f,1.4f); // Tight low boost
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(4.f);   comp.setThreshold(-15.f);
-                    comp.setAttack(1.5f); comp.setRelease(70.f); // Faster VCA style
-                    sat.functionToUse = [](float x){ return 0.45f*x+0.55f*std::tanh(2.2f*x); }; // Transformer sat
-                    post.setGainLinear(0.88f);
-                    break;
-
-                case 22: // ── API 2500 ──────────────────────────────────────────
-                    pre.setGainLinear(1.25f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,90.f,0.8f,1.5f); // API Thrust-like low end
-                    // tone2 bypassed by default
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(3.f);   comp.setThreshold(-12.f);
-                    comp.setAttack(0.8f); comp.setRelease(60.f); // Punchy comp
-                    sat.functionToUse = [](float x){ return 0.4f*x+0.6f*std::tanh(2.6f*x); }; // API Opamp sat
-                    post.setGainLinear(0.86f);
-                    break;
-
-                case 23: // ── Ampex 440 ────────────────────────────────────────
-                    pre.setGainLinear(1.28f);
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,50.f,0.7f,1.7f); // 30 IPS bump
-                    fatChain.setBypassed<2>(false); // Enable tone2
-                    tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,14000.f,0.8f,0.9f); // Slight HF cut pre-sat
-                    fatChain.setBypassed<3>(false); // Enable comp
-                    comp.setRatio(2.f);   comp.setThreshold(-16.f);
-                    comp.setAttack(5.f); comp.setRelease(60.f); // Subtle tape comp
-                    sat.functionToUse = [](float x){ return 0.7f*std::tanh(2.1f*x)+0.3f*x; }; // Tape sat
-                    post.setGainLinear(0.84f);
-                    break;
-
-                case 24: // ── Moog Ladder Out ──────────────────────────────────
-                    pre.setGainLinear(1.30f); // Drive it
-                    tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr,17000.f); // Transformer roll-off
-                    // tone2 bypassed by default
-                    // comp bypassed by default
-                    sat.functionToUse = [](float x){ return std::tanh(3.0f*x); }; // Simple strong tanh for ladder drive
-                    post.setGainLinear(0.80f);
-                    break;
-
-                default: // Should not happen, but provide a fallback (e.g., bypass or first mode)
-                     // Option 1: Bypass all fatness stages
-                     fatChain.setBypassed<0>(true);
-                     fatChain.setBypassed<1>(true);
-                     fatChain.setBypassed<2>(true);
-                     fatChain.setBypassed<3>(true);
-                     fatChain.setBypassed<4>(true);
-                     fatChain.setBypassed<5>(true);
-                     // Option 2: Default to mode 0 (Tape Thick)
-                     // pre.setGainLinear(1.20f); ... etc
-                    break;
-            }
+        // Eco / Standard: run the saturator from its prebuilt lookup table.
+        // A tier change only swaps the function, never the chain.
+        if (consoleTablePoints != activeQuality.shaperTablePoints)
+        {
+            consoleTablePoints = activeQuality.shaperTablePoints;
+            auto* table = consoleShaperTables().find(fatMode, consoleTablePoints);
+            fatChain.get<4>().functionToUse = table != nullptr ? table->makeFunction() : consoleSaturator;
         }
 
         juce::dsp::AudioBlock<float> blk(buffer);
@@ -924,6 +973,8 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
     }
     // ---------------------------------------------------------------------------
 
+    outputGate.update(postInputSilent, TailGate::isSilent(buffer), buffer.getNumSamples());
+
     // Apply dithering if ENH_DITHER is enabled
     if (enhDitherParam && *enhDitherParam > 0.5f)
     {
@@ -946,6 +997,455 @@ void AllSynthPluginAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer
     // Apply master gain at the end of the signal chain
     if (masterGainParam)
         buffer.applyGain(*masterGainParam);
+
+    // ---------- CPU deadline watchdog ---------------------------------------
+    // Compare this block's time with its real-time budget. Close to the
+    // deadline, fade out the quietest release tails rather than risk an xrun.
+    if (! isNonRealtime() && buffer.getNumSamples() > 0)
+    {
+        const double elapsed = juce::Time::highResolutionTicksToSeconds(
+                                   juce::Time::getHighResolutionTicks() - blockStartTicks);
+        const double budget  = buffer.getNumSamples() / getSampleRate();
+        const float  load    = float(elapsed / budget);
+
+        // fast attack, slow decay, so one spike keeps us careful for a while
+        cpuLoad = juce::jmax(load, cpuLoad * 0.95f);
+
+        if (cpuLoad > shedLoadThreshold)
+            synth.shedQuietestVoices(cpuLoad > 0.95f ? 2 : 1);
+    }
+}
+
+//==============================================================================
+void AllSynthPluginAudioProcessor::configureConsole(FatChain& chain, int mode, double sr)
+{
+    auto& pre   = chain.get<0>();
+    auto& tone1 = chain.get<1>();
+    auto& tone2 = chain.get<2>();
+    auto& comp  = chain.get<3>();
+    auto& sat   = chain.get<4>();
+    auto& post  = chain.get<5>();
+
+    // --- Reset bypass states before setting for current mode ---
+    chain.setBypassed<1>(false); // Assume tone1 is used unless bypassed below
+    chain.setBypassed<2>(true);  // Assume tone2 is NOT used unless enabled below
+    chain.setBypassed<3>(true);  // Assume comp is NOT used unless enabled below
+
+    switch (mode)
+    {
+        case 0:   // ───── Tape Thick ──────────────────────────────────────
+            pre.setGainLinear(1.20f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeLowShelf(sr, 200.f, 0.7f, 1.5f);
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x)
+            {
+                return 0.6f * x + 0.4f * std::tanh(1.8f * x);
+            };
+            post.setGainLinear(0.83f);
+            break;
+
+        case 1:   // ───── Warm Tube ──────────────────────────────────────
+            pre.setGainLinear(1.30f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeLowPass(sr, 14000.f);   // soft HF
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x)
+            {
+                return 0.4f * x + 0.6f * std::tanh(2.5f * x);  // richer
+            };
+            post.setGainLinear(0.80f);
+            break;
+
+        case 2:   // ───── Deep Console ───────────────────────────────────
+            pre.setGainLinear(1.25f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeHighShelf(sr, 6000.f, 0.8f, 0.9f); // tiny HF dip
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setThreshold(-12.f);
+            comp.setRatio(2.0f);
+            sat.functionToUse = [](float x)
+            {
+                return 0.55f * std::tanh(2.0f * x) + 0.45f * x;
+            };
+            post.setGainLinear(0.90f);
+            break;
+
+        case 3:   // ───── Punch Glue ────────────────────────────────────
+            pre.setGainLinear(1.10f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeHighShelf(sr, 5000.f, 0.8f, 1.25f);
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setThreshold(-18.f);
+            comp.setRatio(4.0f);
+            comp.setAttack(5.f);
+            comp.setRelease(60.f);
+            sat.functionToUse = [](float x)
+            { return 0.5f * (x + std::tanh(2.2f * x)); };
+            post.setGainLinear(1.00f);
+            break;
+
+        case 4:   // ───── Sub Boom ──────────────────────────────────────
+            pre.setGainLinear(1.15f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeLowShelf(sr, 80.f, 0.7f, 1.8f);
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x)
+            { return 0.7f * x + 0.3f * juce::jlimit(-1.f, 1.f, x * x * x); };
+            post.setGainLinear(0.80f);
+            break;
+
+        case 5:   // ── Opto Smooth ──────────────────────────────────────
+            pre.setGainLinear(1.12f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeHighShelf(sr, 7000.f, 0.7f, 1.10f);
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(3.0f);
+            comp.setThreshold(-16.f);
+            comp.setAttack(10.f); // Slower opto attack
+            comp.setRelease(150.f); // Slower opto release
+            sat.functionToUse = [](float x)
+            {   return 0.5f * x + 0.5f * std::tanh(2.0f * x); };
+            post.setGainLinear(0.92f);
+            break;
+
+        case 6:   // ── Tube Crunch ──────────────────────────────────────
+            pre.setGainLinear(1.40f);
+            // Approximate tilt with a high shelf cut
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeHighShelf(sr, 1200.f, 0.7f, 0.8f); // Gentle high cut
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x)
+            {   float y = std::tanh(3.5f * x);
+                y = 0.6f * y + 0.4f * std::tanh(1.2f * y);     // two stage
+                return y;
+            };
+            post.setGainLinear(0.78f);
+            break;
+
+        case 7:   // ── X-Former Fat ─────────────────────────────────────
+            pre.setGainLinear(1.25f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeLowShelf(sr, 110.f, 0.7f, 1.7f);
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x)
+            {   return 0.55f * std::tanh(2.8f * x)
+                     + 0.45f * std::tanh(0.9f * x); }; // Blend two tanh stages
+            post.setGainLinear(0.85f);
+            break;
+
+        case 8:   // ── Bus Glue ──────────────────────────────────────────
+            pre.setGainLinear(1.10f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeHighShelf(sr, 9000.f, 0.8f, 0.95f); // slight dip
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(1.8f);
+            comp.setThreshold(-10.f);
+            comp.setAttack(2.f);
+            comp.setRelease(80.f);
+            sat.functionToUse = [](float x)
+            {   return 0.6f * x + 0.4f * std::tanh(1.6f * x); };
+            post.setGainLinear(0.95f);
+            break;
+
+        case 9:   // ── Vintage Tape ─────────────────────────────────────
+            pre.setGainLinear(1.30f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>
+                                ::makeLowPass(sr, 15000.f); // Tape HF roll-off
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(2.5f);
+            comp.setThreshold(-15.f);
+            comp.setAttack(5.f);
+            comp.setRelease(60.f);
+            sat.functionToUse = [](float x)
+            {   // soft knee + HF head bump (simulated via blend)
+                float core = std::tanh(2.2f * x);
+                return 0.7f * core + 0.3f * x;
+            };
+            post.setGainLinear(0.85f);
+            break;
+
+        // --- NEW 70s Gear Emulations (Cases 10-24) ---
+
+        case 10:   // ── Neve 1073 ────────────────────────────────────────
+            pre.setGainLinear(1.25f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,  80.f, 0.7f, 1.6f); // Low shelf
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr, 12000.f,0.8f,1.15f); // High shelf
+            // comp bypassed by default
+            sat.functionToUse = [](float x){ return 0.55f*x + 0.45f*std::tanh(2.8f*x); };
+            post.setGainLinear(0.88f);
+            break;
+
+        case 11:   // ── API 312 + 550A ───────────────────────────────────
+            pre.setGainLinear(1.20f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,  50.f, 0.7f, 1.5f); // Low shelf
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sr, 3500.f,1.0f,1.25f); // Mid peak
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setThreshold(-14.f); comp.setRatio(3.f); comp.setAttack(1.f); comp.setRelease(50.f); // API comp settings
+            sat.functionToUse = [](float x){ return 0.5f*x + 0.5f*std::tanh(3.2f*x); };
+            post.setGainLinear(0.90f);
+            break;
+
+        case 12:   // ── Helios 69 ────────────────────────────────────────
+            pre.setGainLinear(1.15f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,10000.f,0.7f,1.25f); // High Shelf
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makePeakFilter(sr, 700.f,1.4f,0.8f); // Mid dip
+            // comp bypassed by default
+            sat.functionToUse = [](float x){ return std::tanh(2.0f*x)*(1.0f-0.1f*x*x); }; // Triode-like
+            post.setGainLinear(0.85f);
+            break;
+
+        case 13:   // ── Studer A80 15 IPS ────────────────────────────────
+            pre.setGainLinear(1.30f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr, 45.f,0.7f,1.8f); // Head bump
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr,15000.f); // HF roll-off
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setThreshold(-17.f); comp.setRatio(2.2f); comp.setAttack(5.f); comp.setRelease(60.f);
+            sat.functionToUse = [](float x)
+            {   float y = 0.6f*std::tanh(2.4f*x) + 0.4f*std::tanh(0.9f*x); // Two-stage tape sat
+                return y; };
+            post.setGainLinear(0.82f);
+            break;
+
+        case 14:   // ── EMI TG-12345 ─────────────────────────────────────
+            pre.setGainLinear(1.18f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighPass(sr, 30.f); // HPF
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr, 5000.f,0.8f,1.2f); // Presence
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setThreshold(-12.f); comp.setRatio(2.f); comp.setAttack(5.f); comp.setRelease(100.f); // TG comp
+            sat.functionToUse = [](float x)
+            {   return 0.5f*x + 0.5f*std::tanh(1.8f*x); };
+            post.setGainLinear(0.90f);
+            break;
+
+        case 15: // ── SSL 4K-Bus ─────────────────────────────────────────
+            pre.setGainLinear(1.08f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 18500.f); // Slight HF roll-off
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(2.0f);  comp.setThreshold(-12.f);
+            comp.setAttack(3.f);  comp.setRelease(100.f); // SSL Bus Comp settings
+            sat.functionToUse = [](float x){ return 0.4f*x+0.6f*std::tanh(1.8f*x); };
+            post.setGainLinear(0.93f);
+            break;
+
+        case 16: // ── LA-2A ─────────────────────────────────────────────
+            pre.setGainLinear(1.20f);
+            // No significant EQ on LA-2A, use flat setting
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 22000.f);
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(3.5f);  comp.setThreshold(-14.f);
+            comp.setAttack(10.f); comp.setRelease(200.f); // Slower opto release
+            sat.functionToUse = [](float x){ return 0.5f*x+0.5f*std::tanh(2.3f*x); }; // Gentle tube sat
+            post.setGainLinear(0.88f);
+            break;
+
+        case 17: // ── Fairchild 670 ────────────────────────────────────
+            pre.setGainLinear(1.25f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr, 16000.f); // Gentle HF roll-off
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(6.f);   comp.setThreshold(-10.f);
+            comp.setAttack(0.8f); comp.setRelease(300.f); // Very slow release
+            sat.functionToUse = [](float x){ return 0.45f*x+0.55f*std::tanh(3.f*x); }; // Rich tube sat
+            post.setGainLinear(0.83f);
+            break;
+
+        case 18: // ── Pultec EQP-1A ────────────────────────────────────
+            pre.setGainLinear(1.15f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr, 30.f,0.7f,1.8f); // Low boost
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,5000.f,0.8f,1.2f); // High boost
+            // comp bypassed by default
+            sat.functionToUse = [](float x){ return 0.65f*x+0.35f*std::tanh(1.6f*x); }; // Light saturation
+            post.setGainLinear(0.85f);
+            break;
+
+        case 19: // ── Quad-Eight ───────────────────────────────────────
+            pre.setGainLinear(1.22f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,100.f,0.9f,1.6f); // Broad low boost
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x){ return 0.55f*std::tanh(2.4f*x)+0.45f*x; }; // Opamp/transformer sat
+            post.setGainLinear(0.87f);
+            break;
+
+        case 20: // ── Harrison 32 ──────────────────────────────────────
+            pre.setGainLinear(1.10f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,8000.f,0.8f,1.15f); // Airy presence
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(1.7f);  comp.setThreshold(-11.f);
+            comp.setAttack(2.f);  comp.setRelease(90.f); // Mix bus comp
+            sat.functionToUse = [](float x){ return 0.5f*x+0.5f*std::tanh(1.7f*x); };
+            post.setGainLinear(0.95f);
+            break;
+
+        case 21: // ── MCI JH-636 ───────────────────────────────────────
+            pre.setGainLinear(1.18f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,60.f,0.7f,1.4f); // Tight low boost
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(4.f);   comp.setThreshold(-15.f);
+            comp.setAttack(1.5f); comp.setRelease(70.f); // Faster VCA style
+            sat.functionToUse = [](float x){ return 0.45f*x+0.55f*std::tanh(2.2f*x); }; // Transformer sat
+            post.setGainLinear(0.88f);
+            break;
+
+        case 22: // ── API 2500 ──────────────────────────────────────────
+            pre.setGainLinear(1.25f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,90.f,0.8f,1.5f); // API Thrust-like low end
+            // tone2 bypassed by default
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(3.f);   comp.setThreshold(-12.f);
+            comp.setAttack(0.8f); comp.setRelease(60.f); // Punchy comp
+            sat.functionToUse = [](float x){ return 0.4f*x+0.6f*std::tanh(2.6f*x); }; // API Opamp sat
+            post.setGainLinear(0.86f);
+            break;
+
+        case 23: // ── Ampex 440 ────────────────────────────────────────
+            pre.setGainLinear(1.28f);
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowShelf(sr,50.f,0.7f,1.7f); // 30 IPS bump
+            chain.setBypassed<2>(false); // Enable tone2
+            tone2.coefficients = juce::dsp::IIR::Coefficients<float>::makeHighShelf(sr,14000.f,0.8f,0.9f); // Slight HF cut pre-sat
+            chain.setBypassed<3>(false); // Enable comp
+            comp.setRatio(2.f);   comp.setThreshold(-16.f);
+            comp.setAttack(5.f); comp.setRelease(60.f); // Subtle tape comp
+            sat.functionToUse = [](float x){ return 0.7f*std::tanh(2.1f*x)+0.3f*x; }; // Tape sat
+            post.setGainLinear(0.84f);
+            break;
+
+        case 24: // ── Moog Ladder Out ──────────────────────────────────
+            pre.setGainLinear(1.30f); // Drive it
+            tone1.coefficients = juce::dsp::IIR::Coefficients<float>::makeLowPass(sr,17000.f); // Transformer roll-off
+            // tone2 bypassed by default
+            // comp bypassed by default
+            sat.functionToUse = [](float x){ return std::tanh(3.0f*x); }; // Simple strong tanh for ladder drive
+            post.setGainLinear(0.80f);
+            break;
+
+        default: // Should not happen, but provide a fallback (e.g., bypass or first mode)
+             // Option 1: Bypass all fatness stages
+             chain.setBypassed<0>(true);
+             chain.setBypassed<1>(true);
+             chain.setBypassed<2>(true);
+             chain.setBypassed<3>(true);
+             chain.setBypassed<4>(true);
+             chain.setBypassed<5>(true);
+             // Option 2: Default to mode 0 (Tape Thick)
+             // pre.setGainLinear(1.20f); ... etc
+            break;
+    }
+}
+
+const Quality::ShaperTableBank& AllSynthPluginAudioProcessor::consoleShaperTables()
+{
+    // One bank per process, like the voices' model tables. The saturators
+    // don't depend on the sample rate, so any rate voices the scratch chain.
+    static const Quality::ShaperTableBank bank (numConsoleModels, [] (int mode)
+    {
+        FatChain chain;
+        configureConsole(chain, mode, 48000.0);
+        return chain.isBypassed<4>() ? std::function<float(float)>() : chain.get<4>().functionToUse;
+    });
+    return bank;
+}
+
+//==============================================================================
+Quality::Settings AllSynthPluginAudioProcessor::resolveQuality() const
+{
+    // Custom: FILTER_OS, overridden by ENH_OS when that is non-zero
+    int customOs = filterOsParam ? int(filterOsParam->load()) : 0;
+    if (enhOsParam && int(enhOsParam->load()) > 0)
+        customOs = int(enhOsParam->load());   // 0…4, same indices as FILTER_OS
+
+    // Offline bounce: always the best the engine can do
+    const int tier = isNonRealtime() ? Quality::high
+                   : qualityParam    ? int(qualityParam->load()) : Quality::custom;
+    return Quality::forTier(tier, customOs);
+}
+
+void AllSynthPluginAudioProcessor::applyQuality(const Quality::Settings& q)
+{
+    const bool force = ! qualityValid;
+
+    // Voices: oscillator maths, shaper tables, filter oversampling
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (auto* v = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
+            v->setQuality(q);
+    synth.setLevelOfDetail(q.levelOfDetail && ! isNonRealtime());
+
+    // Master drive oversampler: switch to the prebuilt variant
+    if (force || ! driveOS
+        || q.driveOsStages != activeQuality.driveOsStages
+        || q.driveKernel   != activeQuality.driveKernel)
+    {
+        jassert(q.driveOsStages >= 1 && q.driveOsStages <= 2);
+        driveOS = driveOsVariants[(juce::jlimit<size_t>(1, 2, q.driveOsStages) - 1) * 2 + (size_t) q.driveKernel].get();
+        driveOS->reset();
+        driveBypassDelay.setDelay(driveOS->getLatencyInSamples());
+        anaDriveL.reset();
+        anaDriveR.reset();
+    }
+
+    reverb.setMonoTank(q.monoReverb);
+    reverb.setMaxFdnLines(q.reverbLines);
+
+    // console saturator switches to (or from) its table on next use
+    if (force || q.shaperTablePoints != activeQuality.shaperTablePoints)
+        consoleTablePoints = -1;
+
+    activeQuality = q;
+    qualityValid  = true;
+
+    // pad up to HQ, so the reported latency stays put across tiers
+    const float own = computeLatency();
+    const float pad = juce::jmax(0.0f, (float) hqLatency - own);
+    jassert(own <= (float) hqLatency + 1.0e-3f);
+    if (force || pad != latencyPad.getDelay())
+    {
+        latencyPad.setDelay(pad);
+        latencyPad.reset();
+    }
+
+    const int latency = juce::jmax(hqLatency, juce::roundToInt(own));
+    if (engineLatency.exchange(latency) != latency)
+        triggerAsyncUpdate();
+}
+
+//==============================================================================
+float AllSynthPluginAudioProcessor::computeLatency() const
+{
+    // All voices share one oversampling mode; take the largest to be safe.
+    float voiceLatency = 0.0f;
+    for (int i = 0; i < synth.getNumVoices(); ++i)
+        if (auto* v = dynamic_cast<SynthVoice*>(synth.getVoice(i)))
+            voiceLatency = juce::jmax(voiceLatency, v->getLatencyInSamples());
+
+    // driveOS is always counted: the bypass path carries the same delay
+    const float driveLatency = driveOS ? driveOS->getLatencyInSamples() : 0.0f;
+    return voiceLatency + driveLatency;
+}
+
+void AllSynthPluginAudioProcessor::handleAsyncUpdate()
+{
+    setLatencySamples(engineLatency.load());
 }
 
 //==============================================================================
@@ -958,6 +1458,7 @@ void AllSynthPluginAudioProcessor::getStateInformation(juce::MemoryBlock& destDa
 {
     // Save the entire state of the plugin
     auto state = parameters.copyState();
+    state.setProperty("IR_PATH", reverb.getImpulseResponseFile().getFullPathName(), nullptr);
     std::unique_ptr<juce::XmlElement> xml(state.createXml());
     copyXmlToBinary(*xml, destData);
 }
@@ -969,6 +1470,11 @@ void AllSynthPluginAudioProcessor::setStateInformation(const void* data, int siz
     {
         // Replace the entire state with the loaded state
         parameters.replaceState(juce::ValueTree::fromXml(*xml));
+
+        // Convolution IR is stored by path; a missing file leaves the last one
+        const juce::String irPath = parameters.state.getProperty("IR_PATH").toString();
+        if (juce::File::isAbsolutePath(irPath))
+            reverb.loadImpulseResponse(juce::File(irPath));
         
         // Make sure missing parameters get reasonable defaults
         if (!parameters.state.hasProperty("CONSOLE_ON"))
@@ -2,9 +2,17 @@
 
 #include <JuceHeader.h>
 #include "DelayLine.h"
+#include "ChorusEnsemble.h"
 #include "ReverbProcessor.h"
 #include "AnalogueDrive.h"
+#include "HalfBandResampler.h"
+#include "QualityModes.h"
+#include "SynthEngine.h"
+#include "VoiceParams.h"
+#include "DspArena.h"
 #include "Presets.h"
+#include "TailGate.h"
+#include <array>
 #include <unordered_map>
 
 // Forward declarations
@@ -12,7 +20,9 @@ class SynthSound;
 class SynthVoice;
 class AllSynthPluginAudioProcessorEditor;
 
-class AllSynthPluginAudioProcessor : public juce::AudioProcessor
+class AllSynthPluginAudioProcessor : public juce::AudioProcessor,
+                                     private juce::Timer,
+                                     private juce::AsyncUpdater
 {
 public:
     AllSynthPluginAudioProcessor();
@@ -26,8 +36,17 @@ public:
     bool isBusesLayoutSupported(const BusesLayout& layouts) const override;
 #endif
 
+    /** Splits blocks larger than the prepared size, so no stage ever sees
+        more samples than it was sized for. */
     void processBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&) override;
 
+    /** Offline bounces run at HQ and render voices on every core. */
+    void setNonRealtime(bool isNonRealtime) noexcept override;
+
+    /** Message thread: WAV impulse response for REVERB_ALGO = Convolution. */
+    bool loadImpulseResponse(const juce::File& wavFile);
+    juce::File getImpulseResponseFile() const { return reverb.getImpulseResponseFile(); }
+
     //==============================================================================
     juce::AudioProcessorEditor* createEditor() override;
     bool hasEditor() const override { return true; }
@@ -38,7 +57,7 @@ public:
     bool acceptsMidi() const override { return true; }
     bool producesMidi() const override { return false; }
     bool isMidiEffect() const override { return false; }
-    double getTailLengthSeconds() const override { return 0.0; }
+    double getTailLengthSeconds() const override { return tailSeconds.load(); }
 
     //==============================================================================
     int getNumPrograms() override { return 1; }
@@ -61,17 +80,24 @@ public:
 
 private:
     //==============================================================================
-    juce::Synthesiser synth;
+    SynthEngine synth;
+    static constexpr int microBlockSize = 32;   // engine render granularity (32 or 64)
+    VoiceParams voiceParams;     // shared by every voice, snapshot once per block
 
     juce::AudioProcessorValueTreeState parameters;
 
-    // NEW – temp buffers for the delay (no per-block alloc)
-    juce::AudioBuffer<float> delayTmpL, delayTmpR;
+    // All block-sized voice memory lives here (sized in prepareToPlay)
+    DspArena arena;
 
     // NEW – FX processors --------------------------------------------------------
-    DelayLine        delayL, delayR;
+    DelayLine        delay;            // stereo, in place
     ReverbProcessor  reverb;
-    juce::dsp::Oversampling<float> driveOS { 2, 2, juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR };
+    // Every drive oversampler a tier can ask for (1 or 2 stages × minimum /
+    // linear phase), built in prepareToPlay; driveOS points at the running one
+    std::array<std::unique_ptr<HalfBandResampler>, 4> driveOsVariants;
+    HalfBandResampler* driveOS = nullptr;         // factor / kernel follow QUALITY
+    // matches driveOS' group delay while the drive is bypassed
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Linear> driveBypassDelay { 64 };
     AnalogueDrive    anaDriveL, anaDriveR;
     float driveAmt { 3.0f };
     bool  driveOn  { false };
@@ -86,6 +112,8 @@ private:
     std::atomic<float>* reverbOnParam  = nullptr;
     std::atomic<float>* reverbTypeParam = nullptr;
     std::atomic<float>* reverbSizeParam = nullptr;
+    std::atomic<float>* reverbAlgoParam = nullptr;   // Freeverb / FDN / Convolution
+    std::atomic<float>* reverbRateParam = nullptr;   // Full / Half / Quarter
     // ---------------------------------------------------------------------------
 
     // NEW – MIDI‑CC mapping -----------------------------------------------------
@@ -110,6 +138,11 @@ private:
         juce::dsp::Gain<float>>;
     FatChain fatChain;
     int previousFatMode = -1; // Cache to avoid rebuilding chain on every buffer
+    std::function<float(float)> consoleSaturator;  // exact saturator of the current mode
+    int consoleTablePoints = -1;                   // table size the saturator runs (-1 = re-pick)
+    static constexpr int numConsoleModels = 25;   // CONSOLE_MODEL choices
+    static void configureConsole(FatChain&, int mode, double sampleRate);
+    static const Quality::ShaperTableBank& consoleShaperTables();
 
     // --- small cache so we only rebuild reverb when the user changes the mode --
     int previousReverbType = -1;
@@ -117,13 +150,48 @@ private:
 
     juce::AudioProcessorValueTreeState::ParameterLayout createParameterLayout();
 
+    void renderBlock(juce::AudioBuffer<float>&, juce::MidiBuffer&);   // at most preparedBlockSize
+
     // ===== NEW – global analogue extras ======================================
     std::atomic<float>* humOnParam    = nullptr;
     std::atomic<float>* crossOnParam  = nullptr;
     std::atomic<float>* masterGainParam = nullptr;
 
-    // ===== Oversampling change tracker ======================================
-    int lastFilterOs = -1; // cache current FILTER_OS to update voices
+    // ===== Voice stereo placement ===========================================
+    std::atomic<float>* voicePanModeParam = nullptr;
+    std::atomic<float>* voiceSpreadParam  = nullptr;
+
+    // ===== Mono engine ========================================================
+    std::atomic<float>* monoModeParam = nullptr;
+    std::atomic<float>* glideParam    = nullptr;
+
+    // ===== QUALITY tier ======================================================
+    std::atomic<float>* qualityParam  = nullptr;
+    std::atomic<float>* filterOsParam = nullptr;
+    Quality::Settings   activeQuality;             // what the engine is running
+    bool                qualityValid = false;      // false = force a full apply
+    int                 preparedBlockSize = 0;     // larger host blocks are split to this
+    juce::MidiBuffer    chunkMidi;                 // MIDI of one such chunk (reserved in prepareToPlay)
+
+    Quality::Settings resolveQuality() const;      // tier → settings (Custom reads FILTER_OS/ENH_OS)
+    void applyQuality(const Quality::Settings&);   // push to voices, drive, reverb
+    // =========================================================================
+
+    // ===== CPU deadline watchdog =============================================
+    float cpuLoad = 0.0f;                              // block time / budget, peak-held
+    static constexpr float shedLoadThreshold = 0.75f;  // start shedding release tails
+    // =========================================================================
+
+    // ===== Latency accounting ================================================
+    // Every tier reports HQ's latency, the longest any of them has; latencyPad
+    // (after the drive) delays the faster tiers by the difference.
+    // applyQuality() recomputes it; a change reaches the host from the
+    // message thread (handleAsyncUpdate), never from inside a render
+    int hqLatency = 0;                       // set in prepareToPlay
+    juce::dsp::DelayLine<float, juce::dsp::DelayLineInterpolationTypes::Thiran> latencyPad { 256 };
+    std::atomic<int> engineLatency { -1 };   // samples the engine now delays by
+    float computeLatency() const;            // sum of the oversampler delays
+    void handleAsyncUpdate() override;       // setLatencySamples(engineLatency)
     // =========================================================================
 
     // ---------- Delay / Reverb perf helpers ---------------------------------
@@ -131,12 +199,45 @@ private:
     std::atomic<float>* delayFbParam    = nullptr;
     std::atomic<float>* delayTimeParam  = nullptr;
     std::atomic<float>* delaySyncParam  = nullptr;
+    std::atomic<float>* delayPingPongParam = nullptr;
+    std::atomic<float>* delayCrossParam    = nullptr;
+    std::atomic<float>* delayTypeParam     = nullptr;   // Digital / Tape / BBD / Multi-Tap
+    std::atomic<float>* delayTapsParam     = nullptr;   // Multi-Tap head pattern
     std::atomic<float>* reverbMixParam  = nullptr;
 
+    // Delay memory: sized for the longest reachable time, allocated on first
+    // use by timerCallback() and handed back after a long bypass
+    static constexpr double delayMaxSeconds     = 2.0;    // DELAY_TIME max
+    static constexpr double delaySyncMinBpm     = 30.0;   // synced 1/1 ≤ 2 s
+    static constexpr double delayReleaseSeconds = 30.0;
+    juce::int64 delayBypassSamples = 0;
+    void timerCallback() override;
+
+    // Tail-aware bypass: a stage is skipped once its tail has died away, and
+    // a silent block with every gate idle is simply cleared
+    static constexpr double delayHoldMarginSeconds = 0.05;   // modulation + time glide
+    static constexpr double reverbHoldSeconds      = 0.5;    // > longest tank loop
+    static constexpr double outputHoldSeconds      = 0.25;   // drive OS + console filters
+    TailGate chorusGate, delayGate, reverbGate, outputGate;
+    std::atomic<double> tailSeconds { 0.0 };                 // chorus + delay + reverb, -60 dB
+
+    // FX_ROUTING = Send: each FX runs wet-only on its own bus
+    std::atomic<float>* fxRoutingParam = nullptr;            // Insert / Send / Send Mono
+    juce::AudioBuffer<float> delaySend, reverbSend;
+    void fillSendBus(juce::AudioBuffer<float>& bus, const juce::AudioBuffer<float>& source,
+                     float level, bool monoSum) noexcept;
+
+    // BBD chorus / ensemble, first of the global FX
+    ChorusEnsemble chorus;
+    std::atomic<float>* chorusOnParam   = nullptr;
+    std::atomic<float>* chorusModeParam = nullptr;   // Juno I / II / I+II / Ensemble
+    std::atomic<float>* chorusMixParam  = nullptr;
+
     float prevDelayMix      = -1.0f;
     float prevDelayFb       = -1.0f;
     float prevDelaySeconds  = -1.0f;
     bool  prevDelaySyncOn   = false;
+    int   prevDelayType     = -1;
     float prevReverbMix     = -1.0f;
 
     // ===== NEW: sound enhancement toggles =======================================
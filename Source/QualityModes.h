@@ -0,0 +1,182 @@
+#pragma once
+#include <JuceHeader.h>
+#include <cmath>
+#include <functional>
+#include <vector>
+#include "HalfBandResampler.h"
+
+//==============================================================================
+// QUALITY tiers – one switch for every CPU / fidelity trade-off in the engine.
+//
+//  Custom    – the individual controls decide (FILTER_OS / ENH_OS, exact
+//              maths, 4× IIR drive, REVERB_ALGO / REVERB_RATE). Default, so
+//              old sessions and presets sound exactly as before.
+//  Eco       – live rigs at 64-sample buffers.
+//  Standard  – everyday production.
+//  HQ        – mixdown / bounce.
+//
+// CPU cost, relative to Standard, estimated from inner-loop operation counts
+// (per voice: oscillators + filter path incl. resampler, plus the shared FX),
+// not profiled. Treat them as a ranking with rough proportions:
+//
+//              osc      filter OS   shaper    drive OS    reverb                  cost
+//   Eco        fast     1×          LUT 256   2× IIR      mono, FDN 8, ¼ rate     ~0.4×
+//   Standard   fast     Auto IIR    LUT 1024  4× IIR      stereo, FDN 16, RATE     1.0×
+//   HQ         exact    4× FIR      exact     4× FIR      FDN 16, full rate       ~2.5×
+//
+// The voice filter path dominates: Standard in Auto averages ~2× across a
+// typical patch, HQ pays 4× plus the FIR half-bands on every voice. The
+// reverb column is the tank the tier allows: Freeverb runs mono in Eco, the
+// FDN is capped at 8 lines, and the reduced rate still never drops below
+// ReverbProcessor::minReducedRate (so it only applies from 88.2 kHz up).
+// Standard leaves REVERB_RATE to the user; HQ always runs the full rate and
+// plays Freeverb patches on the 16-line FDN, the densest tank there is.
+// Convolution is the same in every tier.
+//
+// Every tier but HQ also lets SynthEngine drop release tails and quiet
+// voices to the 1× filter path (level of detail); HQ, and so every bounce,
+// renders each voice at full quality.
+//
+// HQ also has the longest latency (4× FIR in the voices and the drive); the
+// processor pads every other tier up to it, so a tier change, including the
+// switch to HQ for a bounce, never changes what the host compensates for.
+//==============================================================================
+namespace Quality
+{
+    enum Tier { custom = 0, eco, standard, high };
+
+    // shaper lookup-table sizes the tiers use (0 = exact)
+    constexpr int ecoTablePoints      = 256;
+    constexpr int standardTablePoints = 1024;
+
+    struct Settings
+    {
+        bool   fastOscillators   = false;  // table sine + rational tanh in the oscillators
+        int    filterOsMode      = 0;      // FILTER_OS index the voices run
+        size_t driveOsStages     = 2;      // master drive runs at 2^stages ×
+        HalfBandResampler::Kernel driveKernel = HalfBandResampler::Kernel::minimumPhase;
+        int    shaperTablePoints = 0;      // 0 = exact saturators, else lookup-table size
+        bool   monoReverb        = false;  // one Freeverb tank fed (L+R)/2
+        int    reverbLines       = 16;     // FDN line cap (8 or 16)
+        int    reverbDivider     = 0;      // REVERB_RATE divider forced, 0 = the parameter decides
+        int    reverbAlgo        = -1;     // REVERB_ALGO forced on Freeverb/FDN, -1 = the parameter decides
+        bool   levelOfDetail     = true;   // cheap path for release tails / quiet voices
+        float  relativeCpu       = 1.0f;   // estimate, see table above
+
+        bool operator== (const Settings& o) const noexcept
+        {
+            return fastOscillators   == o.fastOscillators
+                && filterOsMode      == o.filterOsMode
+                && driveOsStages     == o.driveOsStages
+                && driveKernel       == o.driveKernel
+                && shaperTablePoints == o.shaperTablePoints
+                && monoReverb        == o.monoReverb
+                && reverbLines       == o.reverbLines
+                && reverbDivider     == o.reverbDivider
+                && reverbAlgo        == o.reverbAlgo
+                && levelOfDetail     == o.levelOfDetail;
+        }
+        bool operator!= (const Settings& o) const noexcept { return ! (*this == o); }
+    };
+
+    /** customFilterOs is the FILTER_OS / ENH_OS choice used by the Custom tier. */
+    inline Settings forTier (int tier, int customFilterOs) noexcept
+    {
+        using Kernel = HalfBandResampler::Kernel;
+        Settings s;
+
+        switch (tier)
+        {
+            case eco:
+                s = { true,  0, 1, Kernel::minimumPhase, ecoTablePoints,      true,   8, 4, -1, true,  0.4f };
+                break;
+            case standard:
+                s = { true,  5, 2, Kernel::minimumPhase, standardTablePoints, false, 16, 0, -1, true,  1.0f };   // 5 = Auto
+                break;
+            case high:
+                s = { false, 4, 2, Kernel::linearPhase,  0,                   false, 16, 1,  1, false, 2.5f };   // 4 = 4× FIR, 1 = FDN
+                break;
+            default: // custom
+                s = { false, customFilterOs, 2, Kernel::minimumPhase, 0, false, 16, 0, -1, true, 1.0f };
+                break;
+        }
+        return s;
+    }
+
+    //==========================================================================
+    // Lookup-table stand-in for a WaveShaper function. The table covers
+    // ±range; anything outside falls back to the exact function. Building one
+    // allocates and evaluates every point, so it only happens in
+    // ShaperTableBank, off the audio thread. makeFunction() only captures
+    // `this`, so handing it to a WaveShaper never allocates.
+    class ShaperTable
+    {
+    public:
+        void build (std::function<float(float)> exact, int numPoints)
+        {
+            exactFn = std::move (exact);
+            points  = numPoints;
+            table.initialise (exactFn, -range, range, (size_t) points);
+        }
+
+        bool isBuilt() const noexcept { return points > 0; }
+
+        float operator() (float x) const noexcept
+        {
+            return std::abs (x) < range ? table.processSampleUnchecked (x) : exactFn (x);
+        }
+
+        std::function<float(float)> makeFunction() const
+        {
+            return [this] (float x) { return (*this) (x); };
+        }
+
+    private:
+        static constexpr float range = 6.0f;
+        std::function<float(float)> exactFn;
+        juce::dsp::LookupTableTransform<float> table;
+        int points = 0;
+    };
+
+    //==========================================================================
+    // Every table a family of shapers (the filter models, the console modes)
+    // can need, at both tier sizes, built up front. Switching model or tier
+    // is then only a pointer lookup.
+    class ShaperTableBank
+    {
+    public:
+        /** shaperFor (i) returns the exact function of shaper i. */
+        ShaperTableBank (int numShapers, const std::function<std::function<float(float)>(int)>& shaperFor)
+            : count (numShapers), tables ((size_t) (numShapers * numSizes))
+        {
+            for (int i = 0; i < numShapers; ++i)
+            {
+                const auto exact = shaperFor (i);
+                if (! exact)
+                    continue;
+
+                for (int s = 0; s < numSizes; ++s)
+                    tables[(size_t) (s * numShapers + i)].build (exact, sizes[s]);
+            }
+        }
+
+        /** nullptr when there is no table of that size (or no shaper). */
+        const ShaperTable* find (int shaper, int numPoints) const noexcept
+        {
+            shaper = juce::jlimit (0, count - 1, shaper);
+            for (int s = 0; s < numSizes; ++s)
+                if (sizes[s] == numPoints)
+                {
+                    auto& t = tables[(size_t) (s * count + shaper)];
+                    return t.isBuilt() ? &t : nullptr;
+                }
+            return nullptr;
+        }
+
+    private:
+        static constexpr int numSizes = 2;
+        static constexpr int sizes[numSizes] { ecoTablePoints, standardTablePoints };
+        int count;
+        std::vector<ShaperTable> tables;
+    };
+}
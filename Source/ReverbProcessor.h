@@ -1,24 +1,86 @@
 #pragma once
 #include <JuceHeader.h>
+#include "FdnReverb.h"
+#include "ConvolutionReverb.h"
+#include "HalfBandResampler.h"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <limits>
+#include <memory>
 
+//==============================================================================
+// REVERB_ALGO engines behind one dry/wet stage (insert, processBlock) or
+// wet-only on a send bus (processWet).
+//
+// Every engine returns wet only; the reverb's own dry level is added here,
+// at the session rate. That lets REVERB_RATE run Freeverb and the FDN at a
+// half or a quarter of the session rate: the input is decimated by
+// HalfBandResampler, the tank runs at the low rate and its output is
+// interpolated back. Tails above ~10 kHz are damped away anyway, and the
+// resampler's group delay only delays the wet signal, so it acts as a short
+// pre-delay and is not reported. The reduced rate never drops below
+// minReducedRate, so at 44.1/48 kHz the setting falls back to full rate.
+// prepare() builds a tank pair, resampler and low-rate buffer for every
+// divider the session rate allows; changing REVERB_RATE only switches
+// between them.
+// Convolution always runs at the session rate; its tail is off the audio
+// thread already and its IR is built for that rate.
+//==============================================================================
 class ReverbProcessor
 {
 public:
+    enum class Algorithm { Freeverb = 0, Fdn, Convolution };   // REVERB_ALGO
+
+    static constexpr double minReducedRate = 40000.0;
+
     ReverbProcessor() = default;
 
     void prepare (const juce::dsp::ProcessSpec& spec)
     {
-        reverb.prepare (spec);
+        sessionSpec = spec;
+        conv.prepare    (spec.sampleRate);
         dryWet.prepare  (spec);
         dryWet.setWetLatency (0);
         dryWet.setWetMixProportion (mix);
-        reset();
+
+        const int maxBlock = (int) spec.maximumBlockSize;
+        input   .setSize (2, maxBlock);
+        inStage .setSize (2, maxBlock + maxRateDivider);
+        wetStage.setSize (2, maxBlock + 2 * maxRateDivider);
+
+        numRates = 0;
+        for (int i = 0; i < (int) rates.size(); ++i)
+        {
+            const int d = 1 << i;
+            if (d > 1 && spec.sampleRate / d < minReducedRate)
+                break;
+            prepareRate (rates[(size_t) i], d);
+            numRates = i + 1;
+        }
+
+        rateDivider = 0;                      // force the switch
+        setRateDivider (requestedDivider);
+
+        if (algorithm == Algorithm::Fdn)      // a session reopened on the FDN
+            active->fdn.allocateNowIfMissing();
+    }
+
+    /** Message thread, nothing rendering (an offline render is starting):
+        build every rate's FDN memory now rather than through service(). */
+    void allocateFdnNow()
+    {
+        for (int i = 0; i < numRates; ++i)
+            rates[(size_t) i].fdn.allocateNowIfMissing();
     }
 
     void reset()
     {
-        reverb.reset();
+        active->reverb.reset();
+        active->fdn.reset();
+        conv.reset();
         dryWet.reset();
+        resetRateStages();
     }
 
     void setMix (float m)
@@ -27,21 +89,283 @@ public:
         dryWet.setWetMixProportion (mix);
     }
 
+    /** Eco quality: feed one Freeverb tank with (L+R)/2 and copy its output
+        to both sides. Roughly halves its cost at the price of width. */
+    void setMonoTank (bool shouldBeMono) noexcept { monoTank = shouldBeMono; }
+
+    /** QUALITY's FDN density. The FDN is stereo by construction, so the
+        cheaper tiers cap its lines (8 or 16) instead. */
+    void setMaxFdnLines (int n) noexcept
+    {
+        fdnLineCap = n;
+        for (int i = 0; i < numRates; ++i)
+            rates[(size_t) i].fdn.setMaxLines (n);
+    }
+
+    /** Switching clears the engine being switched to, so no stale tail plays.
+        Leaving the FDN hands its memory back. */
+    void setAlgorithm (Algorithm a) noexcept
+    {
+        if (a == algorithm)
+            return;
+        if (algorithm == Algorithm::Fdn)
+            for (int i = 0; i < numRates; ++i)
+                rates[(size_t) i].fdn.releaseMemory();
+        algorithm = a;
+        if      (a == Algorithm::Fdn)         active->fdn.reset();
+        else if (a == Algorithm::Convolution) conv.reset();
+        else                                  active->reverb.reset();
+        resetRateStages();
+    }
+
+    /** REVERB_RATE: run Freeverb/FDN at 1/1, 1/2 or 1/4 of the session rate.
+        Audio thread, per block: a change switches to the tanks prepare()
+        built for that divider and clears them; nothing is allocated. */
+    void setRateDivider (int divider) noexcept
+    {
+        requestedDivider = divider;
+
+        int i = 0;
+        while ((2 << i) <= divider && i + 1 < numRates)
+            ++i;
+
+        if ((1 << i) == rateDivider)
+            return;
+        rateDivider = 1 << i;
+        active      = &rates[(size_t) i];
+
+        // only the running rate keeps FDN memory
+        for (int j = 0; j < numRates; ++j)
+            if (j != i)
+                rates[(size_t) j].fdn.releaseMemory();
+
+        reset();
+    }
+
     void setParameters(const juce::Reverb::Parameters& p)
     {
-        reverb.setParameters(p);
+        freeverbParams = p;
+        freeverbParams.dryLevel = 0.0f;
+        for (int i = 0; i < numRates; ++i)
+        {
+            rates[(size_t) i].reverb.setParameters (freeverbParams);
+            rates[(size_t) i].fdn.setLevels (p.wetLevel, p.width);
+        }
+        conv.setLevel  (p.wetLevel);
+        dryGain = p.dryLevel * 2.0f;          // juce::Reverb's dry scale
+    }
+
+    /** Audio thread: seconds for the active engine's tail to fall by 60 dB. */
+    double getTailSeconds() const noexcept
+    {
+        if (algorithm == Algorithm::Fdn)         return active->fdn.getDecaySeconds();
+        if (algorithm == Algorithm::Convolution) return conv.getTailSeconds();
+        if (freeverbParams.freezeMode >= 0.5f)   return std::numeric_limits<double>::infinity();
+
+        // juce::Reverb: comb feedback = roomSize · 0.28 + 0.7, longest comb
+        // 1617 + 23 samples at 44.1 kHz (rate-scaled); damping is LP only
+        const double g = freeverbParams.roomSize * 0.28 + 0.7;
+        return 3.0 * (1640.0 / 44100.0) / -std::log10 (g);
+    }
+
+    /** Message thread: convolution IR from a WAV file (memory-mapped). */
+    bool loadImpulseResponse (const juce::File& f) { return conv.loadImpulseResponse (f); }
+    juce::File getImpulseResponseFile() const       { return conv.getImpulseResponseFile(); }
+
+    /** Message thread (timer): frees IRs the convolution engine has replaced
+        and builds or frees FDN memory. */
+    void service()
+    {
+        conv.service();
+        for (int i = 0; i < numRates; ++i)
+            rates[(size_t) i].fdn.serviceMemory();
+    }
+
+    void setFdnSettings (const FdnReverb::Settings& s) noexcept
+    {
+        fdnSettings = s;
+        for (int i = 0; i < numRates; ++i)
+            rates[(size_t) i].fdn.setSettings (s);
     }
 
+    /** Insert: the reverb's dry level and the REVERB_MIX dry/wet stage. */
     void processBlock (juce::AudioBuffer<float>& buffer)
     {
+        const int numSamples  = buffer.getNumSamples();
+        const int numChannels = juce::jmin (2, buffer.getNumChannels());
+
         juce::dsp::AudioBlock<float> block (buffer);
         dryWet.pushDrySamples (block);
-        reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            input.copyFrom (ch, 0, buffer, ch, 0, numSamples);
+
+        processWet (buffer);
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            buffer.addFrom (ch, 0, input, ch, 0, numSamples, dryGain);
+
         dryWet.mixWetSamples (block);
     }
 
+    /** Send/return: the send bus is replaced by the wet return. No dry copy
+        and no dry/wet stage; the send level does the mixing. */
+    void processWet (juce::AudioBuffer<float>& buffer) noexcept
+    {
+        const int numSamples  = buffer.getNumSamples();
+        const int numChannels = juce::jmin (2, buffer.getNumChannels());
+
+        if (rateDivider > 1 && algorithm != Algorithm::Convolution)
+        {
+            processReduced (buffer, numChannels, numSamples);
+        }
+        else
+        {
+            float* left  = buffer.getWritePointer (0);
+            float* right = numChannels > 1 ? buffer.getWritePointer (1) : nullptr;
+            runEngine (left, right, numSamples);
+        }
+    }
+
 private:
-    juce::dsp::Reverb                 reverb;
+    static constexpr int maxRateDivider = 4;
+
+    // Everything that runs at one REVERB_RATE divider
+    struct RateStage
+    {
+        juce::dsp::Reverb                  reverb;
+        FdnReverb                          fdn;
+        std::unique_ptr<HalfBandResampler> resampler;   // nullptr at full rate
+        juce::AudioBuffer<float>           low;         // decimated input / tank output
+    };
+
+    void prepareRate (RateStage& r, int d)
+    {
+        const auto maxLow = (sessionSpec.maximumBlockSize + (juce::uint32) maxRateDivider) / (juce::uint32) d + 1;
+        const juce::dsp::ProcessSpec lowSpec { sessionSpec.sampleRate / d, maxLow, 2 };
+
+        r.reverb.prepare (lowSpec);
+        r.reverb.setParameters (freeverbParams);
+        r.fdn.prepare    (lowSpec.sampleRate, false);   // memory only once the FDN runs
+        r.fdn.setLevels  (freeverbParams.wetLevel, freeverbParams.width);
+        r.fdn.setMaxLines (fdnLineCap);
+        r.fdn.setSettings (fdnSettings);
+
+        if (d > 1)
+        {
+            r.resampler = std::make_unique<HalfBandResampler> (2, (size_t) (d == 2 ? 1 : 2),
+                                                               HalfBandResampler::Kernel::minimumPhase);
+            r.resampler->initProcessing (maxLow);
+            r.low.setSize (2, (int) maxLow);
+        }
+        else
+        {
+            r.resampler.reset();
+            r.low.setSize (0, 0);
+        }
+    }
+
+    /** Wet only, in place; right may be nullptr. */
+    void runEngine (float* left, float* right, int numSamples) noexcept
+    {
+        if (algorithm == Algorithm::Fdn)
+        {
+            active->fdn.acquireMemory();          // silent until service() has built it
+            active->fdn.process (left, right, numSamples);
+            return;
+        }
+        if (algorithm == Algorithm::Convolution) { conv.process (left, right, numSamples); return; }
+
+        auto& reverb = active->reverb;
+
+        float* chans[] = { left, right };
+        juce::dsp::AudioBlock<float> block (chans, right != nullptr ? 2 : 1, (size_t) numSamples);
+
+        if (monoTank && right != nullptr)
+        {
+            auto l = block.getSingleChannelBlock (0);
+            auto r = block.getSingleChannelBlock (1);
+            l.add (r).multiplyBy (0.5f);
+            reverb.process (juce::dsp::ProcessContextReplacing<float> (l));
+            r.copyFrom (l);
+        }
+        else
+        {
+            reverb.process (juce::dsp::ProcessContextReplacing<float> (block));
+        }
+    }
+
+    /** Decimate → tank at the low rate → interpolate. The resampler needs
+        whole multiples of the divider, so up to divider-1 input samples wait
+        in inStage for the next block and the wet output runs a constant
+        divider-1 samples late (wetStage is primed with that much silence). */
+    void processReduced (juce::AudioBuffer<float>& buffer, int numChannels, int numSamples) noexcept
+    {
+        const int d   = rateDivider;
+        auto&     low = active->low;
+
+        for (int ch = 0; ch < numChannels; ++ch)
+            inStage.copyFrom (ch, stagedIn, buffer, ch, 0, numSamples);
+
+        const int available = stagedIn + numSamples;
+        const int ready     = available - available % d;
+
+        if (ready > 0)
+        {
+            const auto lowN = (size_t) (ready / d);
+            juce::dsp::AudioBlock<const float> highIn (inStage.getArrayOfReadPointers(), (size_t) numChannels, (size_t) ready);
+            auto lowBlock = juce::dsp::AudioBlock<float> (low).getSubsetChannelBlock (0, (size_t) numChannels)
+                                                              .getSubBlock (0, lowN);
+            active->resampler->downsample (highIn, lowBlock);
+
+            runEngine (low.getWritePointer (0), numChannels > 1 ? low.getWritePointer (1) : nullptr, (int) lowN);
+
+            auto highOut = juce::dsp::AudioBlock<float> (wetStage).getSubsetChannelBlock (0, (size_t) numChannels)
+                                                                  .getSubBlock ((size_t) stagedWet, (size_t) ready);
+            active->resampler->upsample (lowBlock, highOut);
+        }
+
+        // hand out numSamples of wet and keep the remainders at the front
+        const int wetLeft = stagedWet + ready - numSamples;
+        const int inLeft  = available - ready;
+        for (int ch = 0; ch < numChannels; ++ch)
+        {
+            buffer.copyFrom (ch, 0, wetStage, ch, 0, numSamples);
+            float* w = wetStage.getWritePointer (ch);
+            std::copy (w + numSamples, w + numSamples + wetLeft, w);
+            float* s = inStage.getWritePointer (ch);
+            std::copy (s + ready, s + available, s);
+        }
+        stagedWet = wetLeft;
+        stagedIn  = inLeft;
+    }
+
+    void resetRateStages() noexcept
+    {
+        inStage.clear();
+        wetStage.clear();
+        stagedIn  = 0;
+        stagedWet = juce::jmax (0, rateDivider - 1);
+        if (active->resampler != nullptr)
+            active->resampler->reset();
+    }
+
+    ConvolutionReverb                 conv;
+    Algorithm                         algorithm { Algorithm::Freeverb };
     juce::dsp::DryWetMixer<float>     dryWet;
     float mix { 0.3f };
-}; 
\ No newline at end of file
+    float dryGain { 0.67f * 2.0f };
+    juce::Reverb::Parameters freeverbParams;
+    FdnReverb::Settings      fdnSettings;
+    bool  monoTank { false };
+    int   fdnLineCap { FdnReverb::maxLines };
+
+    // REVERB_RATE: rates[i] runs at fs / 2^i; the first numRates are prepared
+    juce::dsp::ProcessSpec             sessionSpec { 44100.0, 512, 2 };
+    std::array<RateStage, 3>           rates;
+    RateStage*                         active = &rates[0];
+    int                                numRates = 1;
+    juce::AudioBuffer<float>           input, inStage, wetStage;
+    int requestedDivider = 1, rateDivider = 1;
+    int stagedIn = 0, stagedWet = 0;
+};
@@ -0,0 +1,332 @@
+#include "SynthEngine.h"
+#include "SynthVoice.h"
+
+//----------------------------------------------------------------------
+// prepare
+void SynthEngine::prepare (DspArena& arena)
+{
+    float* chans[2] = { arena.take ((size_t) busBlockSize), arena.take ((size_t) busBlockSize) };
+    voiceBus.setDataToReferTo (chans, 2, busBlockSize);
+}
+
+void SynthEngine::setMicroBlockSize (int numSamples) noexcept
+{
+    microBlock = juce::jlimit (16, maxMicroBlock, numSamples);
+}
+
+//----------------------------------------------------------------------
+// parallel switch (message thread)
+void SynthEngine::setParallelRendering (bool shouldRenderInParallel)
+{
+    if (shouldRenderInParallel && pool == nullptr)
+    {
+        pool = std::make_unique<juce::ThreadPool> (juce::SystemStats::getNumCpus());
+
+        // Built before `parallel` goes true, the only time the audio thread
+        // looks at them; never resized afterwards
+        voiceBuffers.resize ((size_t) getNumVoices());
+        for (auto& b : voiceBuffers)
+            b.setSize (2, busBlockSize);
+    }
+
+    parallel = shouldRenderInParallel;
+}
+
+//----------------------------------------------------------------------
+// voice placement
+void SynthEngine::setVoicePlacement (int mode, float spread) noexcept
+{
+    panMode   = juce::jlimit ((int) panOff, (int) panNote, mode);
+    panSpread = juce::jlimit (0.0f, 1.0f, spread);
+}
+
+float SynthEngine::nextPan (int midiNoteNumber) noexcept
+{
+    switch (panMode)
+    {
+        case panAlternate: return ((noteCounter++ & 1u) ? 1.0f : -1.0f) * panSpread;
+        case panRandom:    return (panRandom.nextFloat() * 2.0f - 1.0f) * panSpread;
+        case panNote:      return juce::jlimit (-1.0f, 1.0f, (float) (midiNoteNumber - 60) / 36.0f) * panSpread;
+        default:           return 0.0f;
+    }
+}
+
+void SynthEngine::noteOn (int midiChannel, int midiNoteNumber, float velocity)
+{
+    if (monoMode != monoOff)
+    {
+        monoNoteOn (midiChannel, midiNoteNumber, velocity);
+        return;
+    }
+
+    juce::Synthesiser::noteOn (midiChannel, midiNoteNumber, velocity);
+
+    // Place the voice that was just (re)started: the newest one on this note
+    SynthesiserVoice* newest = nullptr;
+    for (auto* v : voices)
+        if (v->getCurrentlyPlayingNote() == midiNoteNumber && v->isPlayingChannel (midiChannel)
+            && (newest == nullptr || newest->wasStartedBefore (*v)))
+            newest = v;
+
+    if (auto* sv = dynamic_cast<SynthVoice*> (newest))
+        sv->setPan (nextPan (midiNoteNumber));
+}
+
+void SynthEngine::noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff)
+{
+    if (monoMode != monoOff)
+    {
+        const juce::ScopedLock sl (lock);
+        monoNoteOff (midiNoteNumber, allowTailOff);
+        return;
+    }
+
+    juce::Synthesiser::noteOff (midiChannel, midiNoteNumber, velocity, allowTailOff);
+}
+
+//----------------------------------------------------------------------
+// mono mode
+void SynthEngine::setMonoMode (int mode, float glideSeconds)
+{
+    mode      = juce::jlimit ((int) monoOff, (int) monoHigh, mode);
+    glideTime = juce::jmax (0.0f, glideSeconds);
+
+    if (mode == monoMode)
+        return;
+
+    // Poly ↔ mono: nothing held under the old mode would ever get its note-off
+    allNotesOff (0, true);
+    monoMode = mode;
+    numHeld  = 0;
+    monoNote = -1;
+}
+
+int SynthEngine::monoPriorityNote() const noexcept
+{
+    if (numHeld == 0)
+        return -1;
+
+    int note = heldNotes[(size_t) numHeld - 1];          // last
+    if (monoMode == monoLow || monoMode == monoHigh)
+        for (int i = 0; i < numHeld; ++i)
+            note = monoMode == monoLow ? juce::jmin (note, heldNotes[(size_t) i])
+                                       : juce::jmax (note, heldNotes[(size_t) i]);
+    return note;
+}
+
+void SynthEngine::monoNoteOn (int midiChannel, int midiNoteNumber, float velocity)
+{
+    const juce::ScopedLock sl (lock);
+
+    auto* voice = dynamic_cast<SynthVoice*> (getVoice (0));
+    auto* sound = getSound (0).get();
+    if (voice == nullptr || sound == nullptr || ! sound->appliesToNote (midiNoteNumber)
+        || ! sound->appliesToChannel (midiChannel))
+        return;
+
+    // Re-pressed keys move to the top of the stack
+    const bool legato = numHeld > 0;
+    for (int i = 0; i < numHeld; ++i)
+        if (heldNotes[(size_t) i] == midiNoteNumber)
+        {
+            std::copy (heldNotes.begin() + i + 1, heldNotes.begin() + numHeld, heldNotes.begin() + i);
+            --numHeld;
+            break;
+        }
+    if (numHeld == (int) heldNotes.size())     // drop the oldest
+    {
+        std::copy (heldNotes.begin() + 1, heldNotes.end(), heldNotes.begin());
+        --numHeld;
+    }
+    heldNotes[(size_t) numHeld++] = midiNoteNumber;
+
+    const int target = monoPriorityNote();
+    if (! voice->isVoiceActive())
+    {
+        startVoice (voice, sound, midiChannel, target, velocity);
+        voice->setPan (0.0f);
+    }
+    else if (target != monoNote || ! legato)
+    {
+        // Overlapping keys slide without retriggering; a fresh key after
+        // all were released retriggers, still gliding from the tail's pitch
+        voice->glideTo (target, glideTime, ! legato);
+        voice->setKeyDown (true);
+    }
+    monoNote = target;
+}
+
+void SynthEngine::monoNoteOff (int midiNoteNumber, bool allowTailOff)
+{
+    for (int i = 0; i < numHeld; ++i)
+        if (heldNotes[(size_t) i] == midiNoteNumber)
+        {
+            std::copy (heldNotes.begin() + i + 1, heldNotes.begin() + numHeld, heldNotes.begin() + i);
+            --numHeld;
+            break;
+        }
+
+    auto* voice = dynamic_cast<SynthVoice*> (getVoice (0));
+    if (voice == nullptr || ! voice->isVoiceActive())
+        return;
+
+    if (numHeld > 0)
+    {
+        // Fall back to the next key by priority, legato
+        const int target = monoPriorityNote();
+        if (target != monoNote)
+            voice->glideTo (target, glideTime, false);
+        monoNote = target;
+        return;
+    }
+
+    voice->setKeyDown (false);
+    if (! voice->isSustainPedalDown())
+        stopVoice (voice, 1.0f, allowTailOff);
+}
+
+//----------------------------------------------------------------------
+// CPU-pressure voice shedding
+int SynthEngine::shedQuietestVoices (int maxVoices) noexcept
+{
+    const juce::ScopedLock sl (lock);
+
+    int shed = 0;
+    while (shed < maxVoices)
+    {
+        SynthVoice* quietest = nullptr;
+        for (auto* v : voices)
+            if (auto* sv = dynamic_cast<SynthVoice*> (v))
+                if (sv->isReleasing() && sv->getEnvelopeLevel() > 0.0f
+                    && (quietest == nullptr || sv->getEnvelopeLevel() < quietest->getEnvelopeLevel()))
+                    quietest = sv;
+
+        if (quietest == nullptr)
+            break;
+
+        quietest->shed();     // level ramps to 0 over 5 ms, then the voice frees itself
+        ++shed;
+    }
+    return shed;
+}
+
+void SynthEngine::updateLevelOfDetail() noexcept
+{
+    // The newest voice, and any voice with fewer than fullDetailVoices
+    // sounding voices louder than it, keeps full detail
+    SynthVoice* newest = nullptr;
+    for (auto* v : voices)
+        if (auto* sv = dynamic_cast<SynthVoice*> (v))
+            if (sv->isVoiceActive() && (newest == nullptr || newest->wasStartedBefore (*sv)))
+                newest = sv;
+
+    for (auto* v : voices)
+    {
+        auto* sv = dynamic_cast<SynthVoice*> (v);
+        if (sv == nullptr)
+            continue;
+
+        bool low = levelOfDetail && sv != newest && sv->wantsLowDetail();
+        if (low)
+        {
+            int louder = 0;
+            for (auto* o : voices)
+                if (auto* so = dynamic_cast<SynthVoice*> (o))
+                    if (so != sv && so->isVoiceActive() && so->getEnvelopeLevel() > sv->getEnvelopeLevel())
+                        ++louder;
+            low = louder >= fullDetailVoices;
+        }
+        sv->setLowDetail (low);
+    }
+}
+
+//----------------------------------------------------------------------
+// render
+void SynthEngine::renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples)
+{
+    const int maxChunk = voiceBus.getNumSamples();
+    if (maxChunk == 0)
+    {
+        juce::Synthesiser::renderVoices (outputAudio, startSample, numSamples);
+        return;
+    }
+
+    // The bus is a fixed size, independent of the host's block size
+    while (numSamples > 0)
+    {
+        const int n = juce::jmin (numSamples, maxChunk);
+        voiceBus.clear (0, n);
+        updateLevelOfDetail();
+
+        if (parallel && pool != nullptr && voiceBuffers.size() == (size_t) voices.size())
+            renderVoicesInParallel (n);
+        else
+            for (auto* voice : voices)
+                renderInMicroBlocks (*voice, voiceBus, n);
+
+        // stereo bus → output, once for all voices (mono outputs get L+R / 2)
+        if (outputAudio.getNumChannels() >= 2)
+        {
+            outputAudio.addFrom (0, startSample, voiceBus, 0, 0, n);
+            outputAudio.addFrom (1, startSample, voiceBus, 1, 0, n);
+        }
+        else if (outputAudio.getNumChannels() == 1)
+        {
+            outputAudio.addFrom (0, startSample, voiceBus, 0, 0, n, 0.5f);
+            outputAudio.addFrom (0, startSample, voiceBus, 1, 0, n, 0.5f);
+        }
+
+        startSample += n;
+        numSamples  -= n;
+    }
+}
+
+void SynthEngine::renderInMicroBlocks (juce::SynthesiserVoice& voice, juce::AudioBuffer<float>& dest, int numSamples)
+{
+    if (! voice.isVoiceActive())
+        return;
+
+    for (int pos = 0; pos < numSamples; pos += microBlock)
+        voice.renderNextBlock (dest, pos, juce::jmin (microBlock, numSamples - pos));
+}
+
+void SynthEngine::renderVoicesInParallel (int numSamples)
+{
+    // Only active voices are worth a job
+    int jobs[64];
+    int numJobs = 0;
+    for (int i = 0; i < voices.size() && numJobs < (int) std::size (jobs); ++i)
+        if (voices.getUnchecked (i)->isVoiceActive())
+            jobs[numJobs++] = i;
+
+    if (numJobs <= 1)
+    {
+        for (auto* voice : voices)
+            renderInMicroBlocks (*voice, voiceBus, numSamples);
+        return;
+    }
+
+    std::atomic<int>   remaining { numJobs };
+    juce::WaitableEvent done;
+
+    for (int j = 0; j < numJobs; ++j)
+    {
+        const int v = jobs[j];
+        pool->addJob ([this, v, numSamples, &remaining, &done]
+        {
+            auto& buf = voiceBuffers[(size_t) v];
+            buf.clear (0, numSamples);
+            renderInMicroBlocks (*voices.getUnchecked (v), buf, numSamples);
+
+            if (--remaining == 0)
+                done.signal();
+        });
+    }
+
+    done.wait();
+
+    // Sum in voice order so bounces are bit-identical run to run
+    for (int j = 0; j < numJobs; ++j)
+        for (int ch = 0; ch < 2; ++ch)
+            voiceBus.addFrom (ch, 0, voiceBuffers[(size_t) jobs[j]], ch, 0, numSamples);
+}
@@ -0,0 +1,110 @@
+#pragma once
+#include <JuceHeader.h>
+#include "DspArena.h"
+#include <array>
+#include <vector>
+
+//==============================================================================
+// juce::Synthesiser with a shared voice bus and an optional multi-core renderer.
+//
+// Voices accumulate into a stereo voice bus with their own pan gains (set at
+// note-on by VOICE_PAN_MODE / VOICE_SPREAD); the bus is added to the output
+// once per block for all voices.
+//
+// Mono mode (MONO_MODE): voice 0 plays every note with last/low/high note
+// priority and glides between them; the polyphonic voice search is skipped.
+//
+// Voices always render in fixed micro-blocks (32 or 64 samples), whatever
+// the host block size: per-block parameter updates (cutoff, LFO, envelope
+// settings) happen at a steady rate, each voice's working set stays in L1,
+// and the voices' scratch memory never depends on the host honouring its
+// maximum block size.
+//
+// Realtime: voices render one after another into the bus.
+// Offline (bounce, no deadline): every active voice renders into its own
+// buffer on a worker thread and the results are summed on the caller. Those
+// buffers (8 KB per voice) are allocated the first time parallel rendering
+// is switched on, so realtime-only sessions never carry them.
+//==============================================================================
+class SynthEngine : public juce::Synthesiser
+{
+public:
+    SynthEngine() = default;
+
+    static constexpr int maxMicroBlock = 64;     // voices' scratch size
+    static constexpr int busBlockSize  = 1024;   // voice bus / parallel buffers
+
+    /** Lay out the voice bus in the arena. */
+    void prepare (DspArena& arena);
+    static size_t arenaFloats() noexcept
+    {
+        return 2 * DspArena::padded ((size_t) busBlockSize);
+    }
+
+    /** Internal render granularity in samples, clamped to 16 … maxMicroBlock. */
+    void setMicroBlockSize (int numSamples) noexcept;
+
+    /** Enable/disable the parallel path. Creates the worker pool and the
+        per-voice buffers on first use, so call it from the message thread
+        (e.g. setNonRealtime) after all voices are added. */
+    void setParallelRendering (bool shouldRenderInParallel);
+
+    /** Stereo placement of new notes: mode 0 Off, 1 Alternate, 2 Random,
+        3 Note (low notes left, high right); spread scales the pan width. */
+    void setVoicePlacement (int mode, float spread) noexcept;
+
+    /** Mono mode 0 Off (polyphonic), 1 Last, 2 Low, 3 High note priority;
+        glide is the portamento time in seconds. Switching mode releases
+        every sounding note. Audio thread, before renderNextBlock. */
+    void setMonoMode (int mode, float glideSeconds);
+
+    void noteOn  (int midiChannel, int midiNoteNumber, float velocity) override;
+    void noteOff (int midiChannel, int midiNoteNumber, float velocity, bool allowTailOff) override;
+
+    /** Fade out up to maxVoices of the quietest releasing voices.
+        Returns how many were shed. Audio thread, between blocks. */
+    int shedQuietestVoices (int maxVoices) noexcept;
+
+    /** Level of detail (from the QUALITY tier; off in HQ and offline):
+        releasing and quiet voices drop to the 1× filter path and a
+        control-rate LFO, except the fullDetailVoices loudest and the newest,
+        which always keep full quality. */
+    void setLevelOfDetail (bool enabled) noexcept { levelOfDetail = enabled; }
+    static constexpr int fullDetailVoices = 4;
+
+protected:
+    void renderVoices (juce::AudioBuffer<float>& outputAudio, int startSample, int numSamples) override;
+
+private:
+    void renderVoicesInParallel (int numSamples);
+    void updateLevelOfDetail() noexcept;
+    void renderInMicroBlocks (juce::SynthesiserVoice&, juce::AudioBuffer<float>& dest, int numSamples);
+    float nextPan (int midiNoteNumber) noexcept;
+    int   monoPriorityNote() const noexcept;
+    void  monoNoteOn  (int midiChannel, int midiNoteNumber, float velocity);
+    void  monoNoteOff (int midiNoteNumber, bool allowTailOff);
+
+    std::unique_ptr<juce::ThreadPool>     pool;
+    juce::AudioBuffer<float>              voiceBus;       // stereo sum of all voices
+    std::vector<juce::AudioBuffer<float>> voiceBuffers;   // one per voice (parallel path only)
+    std::atomic<bool> parallel { false };
+    int microBlock = 32;
+    bool levelOfDetail = true;
+
+    // voice placement
+    enum PanMode { panOff = 0, panAlternate, panRandom, panNote };
+    int          panMode     = panOff;
+    float        panSpread   = 0.5f;
+    juce::uint32 noteCounter = 0;
+    juce::Random panRandom;
+
+    // mono mode: keys held, oldest first
+    enum MonoMode { monoOff = 0, monoLast, monoLow, monoHigh };
+    int   monoMode     = monoOff;
+    float glideTime    = 0.0f;
+    std::array<int, 32> heldNotes {};
+    int   numHeld      = 0;
+    int   monoNote     = -1;      // note the mono voice is playing / gliding to
+
+    JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR (SynthEngine)
+};
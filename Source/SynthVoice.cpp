@@ -25,10 +25,24 @@ static bool lfoTableInit = []() {
         lfoTable[i] = std::sin(juce::MathConstants<float>::twoPi * i / LFO_TABLE_SIZE);
     return true;
 }();
+
+// Eco/Standard oscillator sine: linear interpolation in the LFO table
+// (error ~1e-6, far below the oscillator noise floor). t in [0, 1).
+static inline float tableSin(float t) noexcept
+{
+    const float pos = t * (float) LFO_TABLE_SIZE;
+    const int   i0  = (int) pos;
+    const float a   = lfoTable[i0 & (LFO_TABLE_SIZE - 1)];
+    const float b   = lfoTable[(i0 + 1) & (LFO_TABLE_SIZE - 1)];
+    return a + (pos - (float) i0) * (b - a);
+}
 // --------------------------------------------------------------------
 
+static_assert(sizeof(SynthVoice::HotState) == DspArena::alignment, "hot state is one cache line per voice");
+
 //==============================================================================
-SynthVoice::SynthVoice(AudioProcessorValueTreeState& vts) : parameters(vts)
+SynthVoice::SynthVoice(const VoiceParams& sharedParams)
+    : prm(sharedParams.block)
 {
 }
 
@@ -37,31 +51,59 @@ bool SynthVoice::canPlaySound(SynthesiserSound* sound)
     return dynamic_cast<SynthSound*>(sound) != nullptr;
 }
 
-void SynthVoice::prepare(double sampleRate, int samplesPerBlock, int /*outputChannels*/)
+void SynthVoice::prepare(double sampleRate, int samplesPerBlock, int /*outputChannels*/, DspArena& arena,
+                         HotState& hotState, int voiceIndex)
 {
+    hot = &hotState;
     currentSampleRate       = sampleRate;
-    samplesPerBlockCached   = samplesPerBlock;
-    osModeParam            = parameters.getRawParameterValue("FILTER_OS");
-    configureOversampling();   // sets up `oversampler`, calls filterChain.prepare(...) & svFilter.prepare(...)
-    
-    // --- existing dsp::ProcessSpec at voice rate (not used when os on) ---
+
+    // --- dsp::ProcessSpec at voice rate (LFO + 1× filter path) -----------
     dsp::ProcessSpec spec;
     spec.sampleRate       = sampleRate;
     spec.maximumBlockSize = static_cast<uint32>(samplesPerBlock);
     spec.numChannels      = 1;
 
-    // Reset and prepare the filter chain
-    filterChain.reset();
-    filterChain.prepare(spec);
-    
-    // Configure the ladder filter in the chain
-    auto& filter = filterChain.get<filterIndex>();
-    filter.setMode(juce::dsp::LadderFilterMode::LPF24);
+    // Prepare every filter path once at its own (base × factor) rate, so
+    // switching factor never has to re-prepare a filter.
+    for (int p = 0; p < numFilterPaths; ++p)
+    {
+        auto& path  = filterPaths[(size_t) p];
+        path.factor = 1 << p;
+
+        dsp::ProcessSpec specOS { sampleRate * path.factor,
+                                  static_cast<uint32>(samplesPerBlock * path.factor),
+                                  1 };
 
-    // prepare state-variable filter
-    svFilter.reset();
-    svFilter.prepare(spec);
-    svFilter.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+        path.chain.reset();
+        path.chain.prepare(specOS);
+        path.chain.get<filterIndex>().setMode(juce::dsp::LadderFilterMode::LPF24);
+
+        path.svf.reset();
+        path.svf.prepare(specOS);
+        path.svf.setType(juce::dsp::StateVariableTPTFilterType::lowpass);
+
+        // Both kernels of this factor, so a FILTER_OS / QUALITY change only
+        // picks one (configureOversampling) and never allocates mid-stream.
+        // The resampler's second argument is the number of 2× stages.
+        for (auto kernel : { HalfBandResampler::Kernel::minimumPhase, HalfBandResampler::Kernel::linearPhase })
+        {
+            auto& os = path.osVariants[(size_t) kernel];
+            os.reset();
+            if (p > 0)
+            {
+                os = std::make_unique<HalfBandResampler>(1, (size_t) p, kernel);
+                os->initProcessing(static_cast<size_t>(samplesPerBlock));
+            }
+        }
+        path.os = nullptr;
+    }
+
+    currentOsMode = -1;        // force a re-selection for the new resamplers
+    configureOversampling();   // picks the 2× / 4× oversamplers
+    previousModel = -1;        // re-apply the model voicing to every path
+    modelShaperTables();       // build the shared tables here, not mid-block
+
+    fadeSamplesTotal = juce::jmax(1, int(sampleRate * 0.005)); // 5 ms Auto-OS crossfade
 
     adsr.setSampleRate(sampleRate);
 
@@ -70,57 +112,14 @@ void SynthVoice::prepare(double sampleRate, int samplesPerBlock, int /*outputCha
     ampModSmoothed.setCurrentAndTargetValue(1.0f); // Start at no modulation (gain = 1.0)
     // -----------------------------------
 
-    // Allocate scratch buffer once
-    scratchBuffer.setSize(1, samplesPerBlock);
-
-    // Cache parameter pointers once (no per-sample lookup)
-    wave1Param     = parameters.getRawParameterValue("WAVEFORM");
-    wave2Param     = parameters.getRawParameterValue("WAVEFORM2");
-    pulseWidthParam = parameters.getRawParameterValue("PULSE_WIDTH");
-    osc1VolParam    = parameters.getRawParameterValue("OSC1_VOLUME");
-    osc2VolParam    = parameters.getRawParameterValue("OSC2_VOLUME");
-    osc2SemiParam   = parameters.getRawParameterValue("OSC2_SEMI");
-    osc2FineParam   = parameters.getRawParameterValue("OSC2_FINE");
-    lfoOnParam      = parameters.getRawParameterValue("LFO_ON");
-    lfoRateParam    = parameters.getRawParameterValue("LFO_RATE");
-    lfoDepthParam   = parameters.getRawParameterValue("LFO_DEPTH");
-    noiseOnParam    = parameters.getRawParameterValue("NOISE_ON");
-    noiseMixParam   = parameters.getRawParameterValue("NOISE_MIX");
-    modelParam      = parameters.getRawParameterValue("MODEL");
-    cutoffParam     = parameters.getRawParameterValue("CUTOFF");
-    resonanceParam  = parameters.getRawParameterValue("RESONANCE");
-    attackParam     = parameters.getRawParameterValue("ATTACK");
-    decayParam      = parameters.getRawParameterValue("DECAY");
-    sustainParam    = parameters.getRawParameterValue("SUSTAIN");
-    releaseParam    = parameters.getRawParameterValue("RELEASE");
-    // Cache analogue-extra pointers
-    freePhaseParam  = parameters.getRawParameterValue("ANA_FREE");
-    driftParam      = parameters.getRawParameterValue("ANA_DRIFT");
-    filterTolParam  = parameters.getRawParameterValue("ANA_FILT_TOL");
-    vcaClipParam    = parameters.getRawParameterValue("ANA_VCA_CLIP");
-    analogEnvParam  = parameters.getRawParameterValue("ANA_ENV");    // NEW: sqrt-env
-    legatoParam     = parameters.getRawParameterValue("ANA_LEGATO"); // NEW: single-trigger ADSR
-    // NEW: cache LFO sync toggle and initialize tempo-syncable LFO
-    lfoSyncParam    = parameters.getRawParameterValue("LFO_SYNC");
-    lfoSyncDivParam = parameters.getRawParameterValue("LFO_SYNC_DIV");
-    lfoShapeParam   = parameters.getRawParameterValue("LFO_SHAPE");
-    lfoPhaseParam   = parameters.getRawParameterValue("LFO_PHASE");
-    // === NEW : cache routing toggles =======================================
-    lfoToPitchParam  = parameters.getRawParameterValue("LFO_TO_PITCH");
-    lfoToCutoffParam = parameters.getRawParameterValue("LFO_TO_CUTOFF");
-    lfoToAmpParam    = parameters.getRawParameterValue("LFO_TO_AMP");
-    // === NEW : cache enhancement parameter ====================================
-    enhVcaParam      = parameters.getRawParameterValue("ENH_VCA");
-    // -----------------------------------------------------------------------
-
-    // Initialize and prepare LFO oscillator
-    lfoOsc.initialise([](float x) { return std::sin(juce::MathConstants<float>::twoPi * x); }, 128);
-    lfoOsc.prepare(spec);
-    lfoOsc.reset();
-
-    // Random per-voice tolerance (±2% cutoff, ±5% resonance)
-    cutoffTol       = 1.0f + (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 0.04f;
-    resonanceTol    = 1.0f + (juce::Random::getSystemRandom().nextFloat() - 0.5f) * 0.10f;
+    // Scratch buffer in the arena (ch 1 = dry osc copy for Auto-OS fades,
+    // ch 2 = envelope block)
+    float* scratch[3];
+    for (auto& ch : scratch)
+        ch = arena.take((size_t) samplesPerBlock);
+    scratchBuffer.setDataToReferTo(scratch, 3, samplesPerBlock);
+
+    analog.prepare(sampleRate, voiceIndex);
 
     updateParams();
 }
@@ -128,32 +127,53 @@ void SynthVoice::prepare(double sampleRate, int samplesPerBlock, int /*outputCha
 void SynthVoice::startNote(int midiNoteNumber, float velocity, SynthesiserSound*, int /*currentPitchWheelPosition*/)
 {
     // Legato: retrigger only if env is idle or legato disabled
-    if (!legatoParam || *legatoParam < 0.5f || !adsr.isActive())
+    if (!prm.legato || !adsr.isActive())
         adsr.noteOn();
 
     // Set the base frequency for this voice
-    frequency = MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    hot->frequency = MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    hot->glideSamplesRemaining = 0;
 
     // Free-phase toggle: reset phases/integrators only if disabled
-    if (*freePhaseParam < 0.5f)
+    if (!prm.freePhase)
     {
-        phase = 0.0;                              // primary oscillator phase
-        triangleIntegrator = 0.0f;               // triangle integrator
-        phase2 = 0.0;                             // secondary oscillator phase
-        triangleIntegrator2 = 0.0f;              // triangle integrator 2
-        lfoPhase = 0.0;                           // reset LFO phase
+        hot->phase = 0.0;                          // primary oscillator phase
+        hot->triangleIntegrator = 0.0f;           // triangle integrator
+        hot->phase2 = 0.0;                         // secondary oscillator phase
+        hot->triangleIntegrator2 = 0.0f;          // triangle integrator 2
+        hot->lfoPhase = 0.0;                       // reset LFO phase
     }
 
-    // Initial drift per voice
-    drift = 0.0;
-    if (*driftParam > 0.5f)
-        drift = juce::Random::getSystemRandom().nextFloat() * 0.002f - 0.001f; // ±0.1%
-
     ignoreUnused(velocity);
     // Only reconfigure oversampling when a new note starts
     //configureOversampling(); // disabled to avoid stutter on note start
 }
 
+void SynthVoice::glideTo(int midiNoteNumber, float glideSeconds, bool retrigger) noexcept
+{
+    if (retrigger)
+        adsr.noteOn();
+
+    hot->glideTarget = MidiMessage::getMidiNoteInHertz(midiNoteNumber);
+    const int steps = juce::roundToInt(glideSeconds * currentSampleRate);
+    if (steps <= 0)
+    {
+        hot->frequency = hot->glideTarget;
+        hot->glideSamplesRemaining = 0;
+        return;
+    }
+
+    hot->glideRatio = std::pow(hot->glideTarget / hot->frequency, 1.0 / steps);
+    hot->glideSamplesRemaining = steps;
+}
+
+void SynthVoice::setPan(float pan) noexcept
+{
+    const float angle = (juce::jlimit(-1.0f, 1.0f, pan) + 1.0f) * juce::MathConstants<float>::pi * 0.25f;
+    panGainL = juce::MathConstants<float>::sqrt2 * std::cos(angle);
+    panGainR = juce::MathConstants<float>::sqrt2 * std::sin(angle);
+}
+
 void SynthVoice::stopNote(float /*velocity*/, bool allowTailOff)
 {
     adsr.noteOff();
@@ -162,50 +182,38 @@ void SynthVoice::stopNote(float /*velocity*/, bool allowTailOff)
         clearCurrentNote();
 }
 
-float SynthVoice::computeOscSample()
+float SynthVoice::advanceLfo(int numSteps)
 {
-    // Use cached per-block oscillator parameters
-    int   wf1   = cachedWf1;
-    int   wf2   = cachedWf2;
-    float pw    = cachedPw;
-    float vol1  = cachedVol1;
-    float vol2  = cachedVol2;
-
-    // LFO (cached)
-    bool  lfoOn       = cachedLfoOn;
-    float lfoRt       = cachedLfoRate;
-    float lfoDpParam  = cachedLfoDepthParam;           // 0-1 slider
-    float depth  = lfoDpParam * lfoDpParam * 0.08f;    // quadratic, max ≈ 8 %
-
     float lfoRaw = 0.0f;                 // RAW –1 … +1   (no depth applied yet)
-    if (lfoOn)
+    if (prm.lfoOn)
     {
-        double rateHz = lfoRt;
-        if (cachedLfoSync && hostBpm > 0.0)
+        double rateHz = prm.lfoRate;
+        if (prm.lfoSync && hostBpm > 0.0)
         {
             static const std::array<double,7> div = {1,2,4,8,16,1.5,3};
-            int idx = juce::jlimit(0, int(div.size()-1), cachedLfoSyncDiv);
+            int idx = juce::jlimit(0, int(div.size()-1), prm.lfoSyncDiv);
             rateHz = hostBpm / 60.0 / div[idx];
         }
 
         // -------- 2. advance internal phase ---------------------------------
         const double phaseInc = rateHz / currentSampleRate;   // cycles / sample
-        lfoPhase += phaseInc;
-        if (lfoPhase >= 1.0)
-            lfoPhase -= 1.0;
+        hot->lfoPhase += phaseInc * numSteps;
+        if (hot->lfoPhase >= 1.0)
+            hot->lfoPhase -= std::floor(hot->lfoPhase);
 
         // -------- 3. add user phase-offset slider ---------------------------
-        float userOff = cachedLfoPhaseOffset; // 0-1
-        double t = lfoPhase + userOff;
+        float userOff = prm.lfoPhaseOffset; // 0-1
+        double t = hot->lfoPhase + userOff;
         if (t >= 1.0)
             t -= 1.0;                                           // wrap to 0-1
 
         // -------- 4. waveform ----------------------------------------------
-        int shape = cachedLfoShape;
+        int shape = prm.lfoShape;
         float sample = 0.0f;
         switch (shape)
         {
-            case 0:  sample = std::sin(juce::MathConstants<float>::twoPi * (float)t);          break; // Sine
+            case 0:  sample = fastOsc ? tableSin((float)t)
+                                      : std::sin(juce::MathConstants<float>::twoPi * (float)t); break; // Sine
             case 1:  sample = (t < 0.5) ? float(4.0*t - 1.0) : float(3.0 - 4.0*t);             break; // Triangle
             case 2:  sample = float(2.0*t - 1.0);                                              break; // Saw
             case 3:  sample = (t < 0.5) ? 1.0f : -1.0f;                                        break; // Square
@@ -216,25 +224,41 @@ float SynthVoice::computeOscSample()
         lfoRaw = sample;                 // store raw value (-1…+1)
     }
 
-    lastLfoValue = lfoRaw;               // cache for Amp / GUI
+    hot->lastLfoValue = lfoRaw;           // cache for Amp / GUI
+    return lfoRaw;
+}
+
+float SynthVoice::computeOscSample()
+{
+    // Use cached per-block oscillator parameters
+    int   wf1   = prm.wf1;
+    int   wf2   = prm.wf2;
+    float pw    = prm.pulseWidth;
+    float vol1  = prm.vol1;
+    float vol2  = prm.vol2;
+
+    // LFO: per sample, or once per block for low-detail voices
+    const float lfoRaw = lfoControlRate ? hot->lastLfoValue : advanceLfo(1);
 
     // -------- PER-DESTINATION DEPTHS ---------------------------------
-    const float depthLin   = cachedLfoDepthParam;        // 0…1 knob
+    const float depthLin   = prm.lfoDepth;        // 0…1 knob
     const float depthPitch = depthLin * depthLin * 0.08f; // subtle
     const float depthCut   = depthLin * 0.50f;            // ±50 %
     const float depthAmp   = depthLin * 1.00f;            // 0-200 %
 
+    // ---------- Mono glide: ramp the base frequency ------------------
+    if (hot->glideSamplesRemaining > 0)
+        hot->frequency = (--hot->glideSamplesRemaining == 0) ? hot->glideTarget : hot->frequency * hot->glideRatio;
+
     // ---------- PITCH route ------------------------------------------
-    const bool pitchRouteOn = cachedLfoToPitch;
-    const double freqMod = frequency * (1.0
+    const bool pitchRouteOn = prm.lfoToPitch;
+    const double freqMod = hot->frequency * pitchDrift * (1.0
                          + (pitchRouteOn ? lfoRaw * depthPitch : 0.0f));
     const double phaseInc = freqMod / currentSampleRate;
     const float  dt       = static_cast<float>(phaseInc);
 
-    // NEW: 2nd-osc detune offsets
-    float semiOffset = osc2SemiParam ? osc2SemiParam->load() : 0.0f;
-    float fineOffset = osc2FineParam ? osc2FineParam->load() : 0.0f;
-    const double phaseInc2 = phaseInc * cachedDetuneRatio;
+    // 2nd-osc detune ratio (semi + fine, snapshot per block)
+    const double phaseInc2 = phaseInc * prm.detuneRatio;
     const float  dt2       = static_cast<float>(phaseInc2);
 
     auto singleOsc = [&](int waveform, double& ph, float& triInt, double inc, float dtVal) -> float
@@ -256,7 +280,8 @@ float SynthVoice::computeOscSample()
                     if (tmod >= 1.0f) tmod -= 1.0f;
                     sq -= polyBlep(tmod, dt);
                 }
-                sq  = std::tanh(0.9f * sq);   // gentle soft‑clip = rounder
+                sq  = fastOsc ? dsp::FastMathApproximations::tanh(0.9f * sq)
+                              : std::tanh(0.9f * sq);   // gentle soft‑clip = rounder
                 s   = sq * 0.65f;             // ≈ RMS match to saw
                 break;
             }
@@ -270,7 +295,8 @@ float SynthVoice::computeOscSample()
                     if (tmod >= 1.0f) tmod -= 1.0f;
                     pl -= polyBlep(tmod, dt);
                 }
-                pl = std::tanh(0.9f * pl);    // tame the buzz a bit
+                pl = fastOsc ? dsp::FastMathApproximations::tanh(0.9f * pl)
+                             : std::tanh(0.9f * pl);    // tame the buzz a bit
                 s  = pl * 0.65f;              // level‑match
                 break;
             }
@@ -294,7 +320,8 @@ float SynthVoice::computeOscSample()
             case 4: // Sine – pure sine wave
             {
                 // Generate a sine wave from the phase (0 to 1 mapping)
-                s = std::sin(juce::MathConstants<float>::twoPi * t);
+                s = fastOsc ? tableSin(t)
+                            : std::sin(juce::MathConstants<float>::twoPi * t);
                 break;
             }
             default: break;
@@ -305,14 +332,14 @@ float SynthVoice::computeOscSample()
         return s;
     };
 
-    float osc1 = singleOsc(wf1, phase, triangleIntegrator, phaseInc, dt);
-    float osc2 = singleOsc(wf2, phase2, triangleIntegrator2, phaseInc2, dt2);
+    float osc1 = singleOsc(wf1, hot->phase, hot->triangleIntegrator, phaseInc, dt);
+    float osc2 = singleOsc(wf2, hot->phase2, hot->triangleIntegrator2, phaseInc2, dt2);
 
     float out = osc1 * vol1 + osc2 * vol2;
     
     // Add raw white noise if enabled (cached)
-    if (cachedNoiseOn)
-        out = out * (1.0f - cachedNoiseMix) + (rnd.nextFloat() * 2.0f - 1.0f) * cachedNoiseMix;
+    if (prm.noiseOn)
+        out = out * (1.0f - prm.noiseMix) + (rnd.nextFloat() * 2.0f - 1.0f) * prm.noiseMix;
 
     return out;
 }
@@ -322,158 +349,258 @@ void SynthVoice::renderNextBlock(AudioBuffer<float>& outputBuffer, int startSamp
     if (!isVoiceActive())
         return;
 
+    // Analogue motion runs at control rate, whether or not it's switched on,
+    // so enabling it mid-note doesn't jump to a stale trajectory position
+    analog.advance(numSamples);
+    pitchDrift = prm.drift ? analog.getPitchRatio() : 1.0f;
+
     updateParams();
-    cacheOscParams(); // cache atomic params once per block
 
-    const bool useSVF = (static_cast<int>(*modelParam) == 2 ||
-                         static_cast<int>(*modelParam) == 3 ||
-                         static_cast<int>(*modelParam) == 6);
+    if (lfoControlRate)
+        advanceLfo(numSamples);   // one LFO step for the whole block
+
+    const bool useSVF = (prm.model == 2 || prm.model == 3 || prm.model == 6);
+
+    auto& tmp = scratchBuffer;
+    for (int i = 0; i < numSamples; ++i)
+        tmp.setSample (0, i, computeOscSample());
+
+    auto hostBlock = juce::dsp::AudioBlock<float>(tmp)
+                        .getSingleChannelBlock (0)
+                        .getSubBlock (0, (size_t) numSamples);
 
-    // ----- LADDER filter path ---------------------------------------------
-    if (! useSVF)
+    // While an Auto-OS switch is fading, the outgoing path filters its own
+    // copy of the oscillator signal and is crossfaded into the new one.
+    const bool fading = fadeFromPath >= 0;
+    auto fadeBlock = juce::dsp::AudioBlock<float>(tmp)
+                        .getSingleChannelBlock (1)
+                        .getSubBlock (0, (size_t) numSamples);
+    if (fading)
+        fadeBlock.copyFrom (hostBlock);
+
+    processFilterPath (filterPaths[(size_t) activePath], hostBlock, useSVF);
+
+    if (fading)
     {
-        // clear & fill scratchBuffer as before...
-        auto& tmp = scratchBuffer; tmp.clear();
-        for (int i = 0; i < numSamples; ++i)
-            tmp.setSample (0, i, computeOscSample());
+        processFilterPath (filterPaths[(size_t) fadeFromPath], fadeBlock, useSVF);
 
-        auto hostBlock = juce::dsp::AudioBlock<float>(tmp)
-                            .getSubBlock (0, (size_t) numSamples);
+        float* dst = tmp.getWritePointer (0);
+        const float* old = tmp.getReadPointer (1);
+        const float step = 1.0f / (float) fadeSamplesTotal;
+        float g = 1.0f - (float) fadeSamplesRemaining * step;
 
-        if (oversampler)
-        {
-            auto upBlock = oversampler->processSamplesUp(hostBlock);
-            juce::dsp::ProcessContextReplacing<float> ctxUp (upBlock);
-            filterChain.process(ctxUp);
-            oversampler->processSamplesDown(hostBlock);
-        }
-        else
+        const int n = juce::jmin (numSamples, fadeSamplesRemaining);
+        for (int i = 0; i < n; ++i)
         {
-            juce::dsp::ProcessContextReplacing<float> ctx (hostBlock);
-            filterChain.process(ctx);
+            g += step;
+            dst[i] = old[i] + g * (dst[i] - old[i]);
         }
 
-        // ... then ADSR, LFO→amp, copying to outputBuffer unchanged ...
-        for (int sample = 0; sample < numSamples; ++sample)
-        {
-            float filtered = tmp.getSample(0, sample);
-            float env = adsr.getNextSample();
-            if (analogEnvParam && *analogEnvParam > 0.5f)
-                env = std::sqrt(env);   // RC-style analog curve
-
-            // -------- LFO → AMP (Smoothed & Click-safe) ---------------------
-            float targetAmpMod = 1.0f; // Default: no modulation
-            if (lfoOnParam && *lfoOnParam > 0.5f &&
-                lfoToAmpParam && *lfoToAmpParam > 0.5f)
-            {
-                const float depthValue = lfoDepthParam ? lfoDepthParam->load() : 0.0f;
-                const float depth = juce::jlimit(0.0f, 0.9f, depthValue); // 0-0.9
-                targetAmpMod = 1.0f + depth * lastLfoValue; // Target gain: 0.1 to 1.9
-            }
-            ampModSmoothed.setTargetValue(targetAmpMod); // Set the target for the smoother
-            env *= ampModSmoothed.getNextValue();       // Apply the SMOOTHED value
-            // ----------------------------------------------------------------
-
-            float currentSample = filtered * env;
-            
-            // Apply VCA soft-clip if enabled
-            if (enhVcaParam && *enhVcaParam > 0.5f)
-                currentSample = std::tanh(1.05f * currentSample) * (1.0f / 1.05f);
-
-            // Add to all output channels
-            for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
-                outputBuffer.addSample(channel, startSample + sample, currentSample);
-        }
+        fadeSamplesRemaining -= n;
+        if (fadeSamplesRemaining <= 0)
+            fadeFromPath = -1;
+    }
+
+    // ... then envelope × LFO→amp × soft-clip in one pass ...
+    float* envBlock = tmp.getWritePointer(2);
+    adsr.render(envBlock, numSamples);
+
+    // -------- LFO → AMP (Smoothed & Click-safe) ---------------------
+    float targetAmpMod = 1.0f; // Default: no modulation
+    if (prm.lfoOn && prm.lfoToAmp)
+    {
+        const float depth = juce::jlimit(0.0f, 0.9f, prm.lfoDepth); // 0-0.9
+        targetAmpMod = 1.0f + depth * hot->lastLfoValue; // Target gain: 0.1 to 1.9
     }
+    ampModSmoothed.setTargetValue(targetAmpMod);
+
+    // The smoother's ramp over this block, as start + per-sample step
+    const float gain0 = ampModSmoothed.getCurrentValue();
+    const float gainStep = (ampModSmoothed.skip(numSamples) - gain0) / (float) numSamples;
+    // ----------------------------------------------------------------
+
+    float* voiceOut = tmp.getWritePointer(0);
+    if (! prm.enhVca)
+        vcaKernel<VcaClip::none>(voiceOut, envBlock, gain0, gainStep, numSamples);
+    else if (shaperTablePoints > 0)
+        vcaKernel<VcaClip::fast>(voiceOut, envBlock, gain0, gainStep, numSamples);
     else
+        vcaKernel<VcaClip::exact>(voiceOut, envBlock, gain0, gainStep, numSamples);
+
+    // Pan into the engine's stereo voice bus (two multiply-adds per block)
+    outputBuffer.addFrom(0, startSample, voiceOut, numSamples, panGainL);
+    if (outputBuffer.getNumChannels() > 1)
+        outputBuffer.addFrom(1, startSample, voiceOut, numSamples, panGainR);
+
+    if (! adsr.isActive())
+        clearCurrentNote();
+}
+
+template <SynthVoice::VcaClip clip>
+void SynthVoice::vcaKernel(float* signal, const float* env, float gain0, float gainStep, int numSamples) noexcept
+{
+    // signal = softclip(signal · env · ampMod), no calls or branches inside
+    for (int i = 0; i < numSamples; ++i)
     {
-        // SV-filter path – similar wrapping…
-        auto& tmp = scratchBuffer; tmp.clear();
-        for (int i = 0; i < numSamples; ++i)
-            tmp.setSample (0, i, computeOscSample());
+        float x = signal[i] * env[i] * (gain0 + gainStep * (float) (i + 1));
 
-        auto hostBlock = juce::dsp::AudioBlock<float>(tmp)
-                            .getSubBlock(0, (size_t) numSamples);
+        if constexpr (clip == VcaClip::exact)
+            x = std::tanh(1.05f * x) * (1.0f / 1.05f);
+        else if constexpr (clip == VcaClip::fast)   // rational tanh, valid on ±5
+            x = dsp::FastMathApproximations::tanh(juce::jlimit(-5.0f, 5.0f, 1.05f * x)) * (1.0f / 1.05f);
 
-        if (oversampler)
+        signal[i] = x;
+    }
+}
+
+void SynthVoice::processFilterPath(FilterPath& path, juce::dsp::AudioBlock<float> block, bool useSVF)
+{
+    auto run = [&path, useSVF](juce::dsp::AudioBlock<float> b)
+    {
+        if (! useSVF)
         {
-            auto upBlock = oversampler->processSamplesUp(hostBlock);
-            float* d = upBlock.getChannelPointer (0);
-            for (size_t i = 0; i < upBlock.getNumSamples(); ++i)
-                d[i] = svFilter.processSample(0, d[i]);
-            oversampler->processSamplesDown(hostBlock);
+            juce::dsp::ProcessContextReplacing<float> ctx (b);
+            path.chain.process(ctx);
         }
         else
         {
-            for (int i = 0; i < numSamples; ++i)
-                tmp.setSample(0, i,
-                              svFilter.processSample(0, tmp.getSample(0, i)));
+            float* d = b.getChannelPointer (0);
+            for (size_t i = 0; i < b.getNumSamples(); ++i)
+                d[i] = path.svf.processSample(0, d[i]);
         }
+    };
+
+    if (path.os)
+    {
+        run (path.os->processSamplesUp(block));
+        path.os->processSamplesDown(block);
+    }
+    else
+    {
+        run (block);
+    }
 
-        // ... then drive → ADSR → LFO→amp → copy unchanged …
-        for (int sample = 0; sample < numSamples; ++sample)
+    // latency compensation so every path of the mode lines up in time
+    if (path.compActive)
+    {
+        const int mask = (int) path.compRing.size() - 1;
+        const float a = path.compCoef;
+        float x1 = path.compX1, y1 = path.compY1;
+        float* d = block.getChannelPointer (0);
+        int w = path.compWrite;
+        for (size_t i = 0; i < block.getNumSamples(); ++i)
         {
-            float filtered = tmp.getSample(0, sample);
-            float env = adsr.getNextSample();
-            if (analogEnvParam && *analogEnvParam > 0.5f)
-                env = std::sqrt(env);   // RC-style analog curve
-
-            // -------- LFO → AMP (Smoothed & Click-safe) ---------------------
-            float targetAmpMod = 1.0f; // Default: no modulation
-            if (lfoOnParam && *lfoOnParam > 0.5f &&
-                lfoToAmpParam && *lfoToAmpParam > 0.5f)
-            {
-                const float depthValue = lfoDepthParam ? lfoDepthParam->load() : 0.0f;
-                const float depth = juce::jlimit(0.0f, 0.9f, depthValue); // 0-0.9
-                targetAmpMod = 1.0f + depth * lastLfoValue; // Target gain: 0.1 to 1.9
-            }
-            ampModSmoothed.setTargetValue(targetAmpMod); // Set the target for the smoother
-            env *= ampModSmoothed.getNextValue();       // Apply the SMOOTHED value
-            // ----------------------------------------------------------------
-
-            float currentSample = filtered * env;
-            
-            // Apply VCA soft-clip if enabled
-            if (enhVcaParam && *enhVcaParam > 0.5f)
-                currentSample = std::tanh(1.05f * currentSample) * (1.0f / 1.05f);
-
-            for (int channel = 0; channel < outputBuffer.getNumChannels(); ++channel)
-                outputBuffer.addSample(channel, startSample + sample, currentSample);
+            path.compRing[(size_t) w] = d[i];
+            const float x = path.compRing[(size_t) ((w - path.compDelay) & mask)];
+            y1 = a * (x - y1) + x1;
+            x1 = x;
+            d[i] = y1;
+            w = (w + 1) & mask;
         }
+        path.compWrite = w;
+        path.compX1 = x1;
+        path.compY1 = y1;
     }
-
-    if (! adsr.isActive())
-        clearCurrentNote();
 }
 
 void SynthVoice::updateParams()
 {
     // Get parameters
-    const float cutoff    = *cutoffParam;
-    const float resonance = *resonanceParam;
-    currentModel          = static_cast<int>(*modelParam);
-
-    // Noise parameters
-    noiseOn  = *noiseOnParam > 0.5f;
-    noiseMix = *noiseMixParam;
-
-    // Get references to processors in the chain - do this before the early return
-    auto& gain   = filterChain.get<gainIndex>();
-    auto& ladder = filterChain.get<filterIndex>();
-    auto& drive  = filterChain.get<shaperIndex>();
-    
+    const float cutoff    = prm.cutoff;
+    const float resonance = prm.resonance;
+    currentModel          = prm.model;
+
     // Smooth parameter changes
     cutoffSmoothed   .setTargetValue(cutoff);
     resonanceSmoothed.setTargetValue(resonance);
 
-    // Return early if only cutoff / resonance changed
-    if (currentModel == previousModel)
-        goto updateFilterOnly;
+    // Only re-voice the filter paths when the model changes
+    if (currentModel != previousModel)
+    {
+        previousModel = currentModel;  // remember for next call
+
+        for (auto& path : filterPaths)
+            applyModelVoicing(currentModel, path.chain);
+
+        modelDrive = estimateShaperDrive(filterPaths[0].chain.get<shaperIndex>().functionToUse);
+
+        // Eco / Standard: swap the exact shaper for its prebuilt lookup table
+        if (auto* table = modelShaperTables().find(currentModel, shaperTablePoints))
+            for (auto& path : filterPaths)
+                path.chain.get<shaperIndex>().functionToUse = table->makeFunction();
+
+        // Low detail runs the model's lookup table where the tier runs the
+        // exact shaper. The table follows the curve to about -90 dB, so the
+        // swap changes neither level nor character; linear models have no
+        // table and keep their shaper.
+        fullShaper = filterPaths[0].chain.get<shaperIndex>().functionToUse;
+        auto* detailTable = shaperTablePoints == 0
+                              ? modelShaperTables().find(currentModel, Quality::standardTablePoints)
+                              : nullptr;
+        detailShaper = detailTable != nullptr ? detailTable->makeFunction() : fullShaper;
+        if (lowDetail)
+            for (auto& path : filterPaths)
+                path.chain.get<shaperIndex>().functionToUse = detailShaper;
+    }
 
-    previousModel = currentModel;  // remember for next call
-    
-    // Configure based on synth model
-    switch (currentModel)
+    // -------- LFO → CUTOFF  -----------------------------------------
+    float modCutoff = cutoffSmoothed.getTargetValue();
+
+    if (prm.lfoOn && prm.lfoToCutoff)
+    {
+        const float depthCut = prm.lfoDepth * 0.50f;              // ±50 %
+        const float lfoSample = hot->lastLfoValue;                 // raw
+        modCutoff = juce::jlimit(20.0f, 20000.0f,
+                                 modCutoff * (1.0f + depthCut * lfoSample));
+    }
+
+    // ANA_FILT_TOL: component tolerance plus slow wander
+    if (prm.filterTol)
+        modCutoff = juce::jlimit(20.0f, 20000.0f, modCutoff * analog.getCutoffScale());
+
+    cutoffSmoothed.setTargetValue(modCutoff);
+
+    // Every path is prepared at its true (base × factor) rate, so the same
+    // cutoff in Hz gives the same response whichever path is running.
+    const float nextCut    = cutoffSmoothed.getNextValue();
+    const float currentCut = cutoffSmoothed.getCurrentValue();
+    const float nextRes    = resonanceSmoothed.getNextValue()
+                           * (prm.filterTol ? analog.getResonanceScale() : 1.0f);
+
+    for (auto& path : filterPaths)
+    {
+        auto& ladder = path.chain.get<filterIndex>();
+        ladder.setCutoffFrequencyHz(nextCut);
+        ladder.setResonance(nextRes);
+
+        path.svf.setCutoffFrequency(currentCut);
+        path.svf.setResonance(nextRes);
+    }
+
+    if (lowDetail)
+        switchToPath(0);                   // no oversampling for tails
+    else if (autoOs)
+        chooseAutoPath(nextCut, nextRes);
+    else
+        switchToPath(fixedPath);
+
+    // ADSR
+    adsrParams.attack = prm.attack;
+    adsrParams.decay = prm.decay;
+    adsrParams.sustain = prm.sustain;
+    adsrParams.release = prm.release;
+
+    // ANA_ENV: true RC segments instead of linear ramps
+    adsr.setParameters(adsrParams, prm.analogEnv);
+}
+
+void SynthVoice::applyModelVoicing(int model, FilterChain& chain)
+{
+    auto& gain   = chain.get<gainIndex>();
+    auto& ladder = chain.get<filterIndex>();
+    auto& drive  = chain.get<shaperIndex>();
+
+    switch (model)
     {
         case 0: // Minimoog
             ladder.setMode(juce::dsp::LadderFilterMode::LPF24);
@@ -895,133 +1022,190 @@ void SynthVoice::updateParams()
             drive.functionToUse = [](float x){ return std::tanh(1.25f * x); };
             break;
     }
-    
-updateFilterOnly:
-    // -------- LFO → CUTOFF  -----------------------------------------
-    float modCutoff = cutoffSmoothed.getTargetValue();
+}
 
-    if (lfoOnParam && *lfoOnParam > 0.5f &&
-        lfoToCutoffParam && *lfoToCutoffParam > 0.5f)
+const Quality::ShaperTableBank& SynthVoice::modelShaperTables()
+{
+    // One bank per process: the model shapers are plain functions, so every
+    // voice of every instance can share the same tables.
+    static const Quality::ShaperTableBank bank (numShaperModels, [] (int model)
     {
-        const float depthCut = (*lfoDepthParam) * 0.50f;          // ±50 %
-        const float lfoSample = lastLfoValue;                     // raw
-        modCutoff = juce::jlimit(20.0f, 20000.0f,
-                                 modCutoff * (1.0f + depthCut * lfoSample));
-    }
+        FilterChain chain;
+        applyModelVoicing(model, chain);
+        return chain.get<shaperIndex>().functionToUse;
+    });
+    return bank;
+}
 
-    cutoffSmoothed.setTargetValue(modCutoff);
+float SynthVoice::estimateShaperDrive(const std::function<float(float)>& shaper)
+{
+    // Deviation of the shaper from a straight line through 0, 0.5 and 1:
+    // 0 for a linear stage, ~0.3 for tanh(1.6x), ~0.4 for x·tanh(x).
+    if (! shaper)
+        return 0.0f;
+
+    const float half = 2.0f * shaper(0.5f);
+    const float full = shaper(1.0f);
+    const float norm = juce::jmax(std::abs(half), std::abs(full), 1.0e-3f);
+    return juce::jlimit(0.0f, 1.0f, std::abs(half - full) / norm);
+}
 
-    // Advanced adjustment for consistent filter response across oversampling rates
-    float nextCut = cutoffSmoothed.getNextValue();
-    float currentCut = cutoffSmoothed.getCurrentValue();
-    
-    if (oversampler)
+void SynthVoice::chooseAutoPath(float cutoffHz, float resonance)
+{
+    // Harmonics reaching the shaper stop roughly at the cutoff, pushed up by
+    // the resonant peak; the note itself sets a floor for open filters.
+    const float nyquist = float(currentSampleRate * 0.5);
+    const float bandTop = juce::jmax(float(hot->frequency), cutoffHz * (1.0f + 2.0f * resonance));
+    const float bright  = juce::jlimit(0.0f, 1.0f, bandTop / nyquist);
+
+    // The ladder has its own tanh stage, so even "clean" models carry a floor
+    const float risk = (0.15f + modelDrive) * bright;
+
+    constexpr float up2 = 0.12f, up4 = 0.25f, hysteresis = 0.75f;
+
+    int wanted = activePath;
+    if      (risk >= up4)                                    wanted = 2;
+    else if (risk >= up2 && activePath < 1)                  wanted = 1;
+    else if (activePath == 2 && risk < up4 * hysteresis)     wanted = (risk >= up2 ? 1 : 0);
+    else if (activePath == 1 && risk < up2 * hysteresis)     wanted = 0;
+
+    switchToPath(wanted);
+}
+
+void SynthVoice::switchToPath(int wanted)
+{
+    // Don't stack switches; finish the current fade first
+    if (wanted == activePath || fadeFromPath >= 0)
+        return;
+
+    // Bring the incoming path in from a clean state rather than whatever it
+    // held the last time it was used
+    auto& next = filterPaths[(size_t) wanted];
+    next.chain.reset();
+    next.svf.reset();
+    next.compRing.fill(0.0f);
+    next.compX1 = next.compY1 = 0.0f;
+    if (next.os) next.os->reset();
+
+    if (isVoiceActive())
     {
-        const float rawFactor = static_cast<float>(oversampler->getOversamplingFactor());
-        // Further refine cutoff scaling: slightly less reduction for 2×, even less for 4×
-        float compRatio = (rawFactor <= 2.0f ? 0.4f : 0.3f);
-        float scale = rawFactor * compRatio;
-        nextCut    /= scale;
-        currentCut /= scale;
+        fadeFromPath         = activePath;
+        fadeSamplesRemaining = fadeSamplesTotal;
     }
-    
-    // Apply the adjusted cutoff values
-    ladder.setCutoffFrequencyHz(nextCut);
-    ladder.setResonance(resonanceSmoothed.getNextValue());
-    
-    svFilter.setCutoffFrequency(currentCut);
-    svFilter.setResonance(resonanceSmoothed.getCurrentValue());
+    activePath = wanted;
+}
 
-    // ADSR
-    adsrParams.attack = *attackParam;
-    adsrParams.decay = *decayParam;
-    adsrParams.sustain = *sustainParam;
-    adsrParams.release = *releaseParam;
+void SynthVoice::setLowDetail(bool shouldBeLow)
+{
+    if (shouldBeLow == lowDetail)
+        return;
+    lowDetail      = shouldBeLow;
+    lfoControlRate = shouldBeLow;
+
+    if (fullShaper)   // not voiced yet → updateParams handles it
+        for (auto& path : filterPaths)
+            path.chain.get<shaperIndex>().functionToUse = shouldBeLow ? detailShaper : fullShaper;
+}
+
+void SynthVoice::setQuality(const Quality::Settings& settings)
+{
+    fastOsc = settings.fastOscillators;
 
-    adsr.setParameters(adsrParams);
+    if (settings.shaperTablePoints != shaperTablePoints)
+    {
+        shaperTablePoints = settings.shaperTablePoints;
+        previousModel     = -1;     // re-voice with (or without) the table
+    }
+
+    if (settings.filterOsMode != requestedOsMode)
+    {
+        requestedOsMode = settings.filterOsMode;
+        configureOversampling();
+    }
 }
 
 void SynthVoice::configureOversampling()
 {
-    const int desired = osModeParam ? int(osModeParam->load()) : 0;
+    const int desired = requestedOsMode;
     if (desired == currentOsMode)
         return;
     currentOsMode = desired;
 
-    // Determine factor and filter type based on mode
+    // Determine factor and kernel based on mode
+    using Kernel  = HalfBandResampler::Kernel;
     size_t factor = 1;
-    auto   ftype  = juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR;
+    auto   kernel = Kernel::minimumPhase;
     switch (desired)
     {
         case 1: // 2× IIR
             factor = 2;
-            ftype  = juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR;
+            kernel = Kernel::minimumPhase;
             break;
         case 2: // 4× IIR
             factor = 4;
-            ftype  = juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR;
+            kernel = Kernel::minimumPhase;
             break;
         case 3: // 2× FIR Equiripple
             factor = 2;
-            ftype  = juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple;
+            kernel = Kernel::linearPhase;
             break;
         case 4: // 4× FIR Equiripple
             factor = 4;
-            ftype  = juce::dsp::Oversampling<float>::filterHalfBandFIREquiripple;
+            kernel = Kernel::linearPhase;
+            break;
+        case autoOsMode: // Auto – 1×/2×/4× IIR chosen per block
+            factor = 1;
+            kernel = Kernel::minimumPhase;
             break;
         default:
             factor = 1;
-            ftype  = juce::dsp::Oversampling<float>::filterHalfBandPolyphaseIIR; // default
+            kernel = Kernel::minimumPhase; // default
             break;
     }
 
-    if (factor == 1)
-    {
-        oversampler.reset();
-    }
-    else
+    autoOs = (desired == autoOsMode);
+
+    // Enable an oversampler only for the paths this mode can actually run,
+    // from the variants prepare() built; nothing is allocated here.
+    for (int p = 1; p < numFilterPaths; ++p)
     {
-        oversampler = std::make_unique<juce::dsp::Oversampling<float>>(1, factor, ftype);
-        oversampler->initProcessing (static_cast<uint32>(samplesPerBlockCached));
+        auto& path = filterPaths[(size_t) p];
+        path.os = (autoOs || (size_t) path.factor == factor) ? path.osVariants[(size_t) kernel].get()
+                                                             : nullptr;
+        if (path.os)
+            path.os->reset();
     }
 
-    // re-prepare both filterChain and svFilter at new (base × factor) rate
-    const double srOS = currentSampleRate * double(factor);
-    juce::dsp::ProcessSpec specOS {
-        srOS,
-        static_cast<uint32>(samplesPerBlockCached * factor),
-        1
-    };
+    activePath   = (factor >= 4 ? 2 : factor == 2 ? 1 : 0);
+    fixedPath    = activePath;
+    fadeFromPath = -1;
 
-    filterChain.reset();  filterChain.prepare(specOS);
-    svFilter.reset();     svFilter.prepare   (specOS);
-}
+    // Pad every path up to the slowest one this mode can run, so Auto
+    // switches don't jump in time and the host sees one constant latency.
+    osLatency = 0.0f;
+    for (auto& path : filterPaths)
+        if (path.os)
+            osLatency = juce::jmax(osLatency, path.os->getLatencyInSamples());
 
-void SynthVoice::cacheOscParams()
-{
-    cachedWf1   = wave1Param   ? int(wave1Param->load())   : 0;
-    cachedWf2   = wave2Param   ? int(wave2Param->load())   : 0;
-    cachedPw    = pulseWidthParam ? pulseWidthParam->load() : 0.0f;
-    cachedVol1  = osc1VolParam    ? osc1VolParam->load()    : 0.0f;
-    cachedVol2  = osc2VolParam    ? osc2VolParam->load()    : 0.0f;
-    // Cache LFO parameters
-    cachedLfoOn          = lfoOnParam      && *lfoOnParam > 0.5f;
-    cachedLfoRate        = lfoRateParam    ? lfoRateParam->load()    : 0.0f;
-    cachedLfoDepthParam  = lfoDepthParam   ? lfoDepthParam->load()   : 0.0f;
-    cachedLfoSync        = lfoSyncParam    && *lfoSyncParam > 0.5f;
-    cachedLfoSyncDiv     = lfoSyncDivParam ? int(lfoSyncDivParam->load()) : 2;
-    cachedLfoShape       = lfoShapeParam   ? int(lfoShapeParam->load())   : 0;
-    cachedLfoPhaseOffset = lfoPhaseParam   ? lfoPhaseParam->load()   : 0.0f;
-    cachedLfoToPitch     = lfoToPitchParam && *lfoToPitchParam > 0.5f;
-    cachedLfoToCutoff    = lfoToCutoffParam&& *lfoToCutoffParam > 0.5f;
-    cachedLfoToAmp       = lfoToAmpParam   && *lfoToAmpParam > 0.5f;
-    // Cache noise parameters
-    cachedNoiseOn        = noiseOnParam    && *noiseOnParam > 0.5f;
-    cachedNoiseMix       = noiseMixParam   ? noiseMixParam->load()   : 0.0f;
-    // Cache detune ratio (semi+fine offsets)
+    for (auto& path : filterPaths)
     {
-        float semiOffset = osc2SemiParam ? osc2SemiParam->load() : 0.0f;
-        float fineOffset = osc2FineParam ? osc2FineParam->load() : 0.0f;
-        cachedDetuneRatio = std::pow(2.0, (semiOffset + fineOffset * 0.01f) / 12.0);
+        // The pad is rarely whole (4× FIR vs 1× is 38.5), and a rounded one
+        // would leave the Auto crossfade blending two signals half a sample
+        // apart. Keep the allpass fraction in [0.5, 1.5), where its group
+        // delay stays flattest; at exactly 1 it is a plain unit delay.
+        const float own = path.os ? path.os->getLatencyInSamples() : 0.0f;
+        const float pad = osLatency - own;
+        const float frac = pad >= 0.5f ? 0.5f + std::fmod(pad - 0.5f, 1.0f) : pad;
+        path.compActive = pad > 1.0e-3f;
+        path.compDelay  = path.compActive ? juce::roundToInt(pad - frac) : 0;
+        path.compCoef   = (1.0f - frac) / (1.0f + frac);
+        jassert(path.compDelay < FilterPath::maxCompDelay);
+        path.compDelay  = juce::jmin(path.compDelay, FilterPath::maxCompDelay - 1);
+        path.compRing.fill(0.0f);
+        path.compWrite = 0;
+        path.compX1 = path.compY1 = 0.0f;
+
+        path.chain.reset();
+        path.svf.reset();
     }
-} 
\ No newline at end of file
+}
@@ -2,11 +2,18 @@
 #include <array>
 #include <cmath>
 #include <atomic>
+#include "HalfBandResampler.h"
+#include "QualityModes.h"
+#include "AnalogEnvelope.h"
+#include "VoiceParams.h"
+#include "DspArena.h"
+#include "AnalogDrift.h"
 
 class SynthVoice : public juce::SynthesiserVoice
 {
 public:
-    SynthVoice(juce::AudioProcessorValueTreeState& vts);
+    /** Voices only read the processor's shared parameter snapshot. */
+    explicit SynthVoice(const VoiceParams& sharedParams);
 
     /** Set host BPM for tempo-synced LFO */
     void setHostBpm(double bpm) { hostBpm = bpm; }
@@ -22,10 +29,71 @@ public:
 
     void renderNextBlock(juce::AudioBuffer<float>&, int startSample, int numSamples) override;
 
-    void prepare(double sampleRate, int samplesPerBlock, int outputChannels);
+    // Hot state: everything computeOscSample() reads or writes per sample,
+    // one cache line per voice. All voices' states sit back to back in one
+    // array in the arena (voice i at index i), so walking the voices walks
+    // contiguous memory, and voices rendered on different threads never
+    // share a line.
+    struct alignas(64) HotState
+    {
+        double phase                 = 0.0;      // primary oscillator
+        double phase2                = 0.0;      // 2nd oscillator
+        double lfoPhase              = 0.0;
+        double frequency             = 440.0;    // base pitch (Hz), glided in mono
+        double glideTarget           = 440.0;    // mono glide destination (Hz)
+        double glideRatio            = 1.0;      // per-sample frequency multiplier
+        float  triangleIntegrator    = 0.0f;     // per-osc triangle integrators
+        float  triangleIntegrator2   = 0.0f;
+        float  lastLfoValue          = 0.0f;     // raw LFO sample (-1…+1)
+        int    glideSamplesRemaining = 0;
+    };
 
-    /** Rebuild oversampler and filters to match current FILTER_OS param */
-    void updateOversampling() { configureOversampling(); }
+    /** The engine's array of numVoices hot states; take it from the arena
+        before preparing the voices. */
+    static HotState* createHotStates(DspArena& arena, int numVoices) noexcept { return arena.create<HotState>((size_t) numVoices); }
+    static size_t hotStateFloats(int numVoices) noexcept { return DspArena::floatsFor<HotState>((size_t) numVoices); }
+
+    /** Scratch memory comes from the processor's arena (see arenaFloats);
+        hotState is this voice's entry of the createHotStates() array and
+        voiceIndex its slot in the engine (seeds the analogue tolerances). */
+    void prepare(double sampleRate, int samplesPerBlock, int outputChannels, DspArena& arena,
+                 HotState& hotState, int voiceIndex);
+    static size_t arenaFloats(int samplesPerBlock) noexcept { return 3 * DspArena::padded((size_t) samplesPerBlock); }
+
+    /** Apply the processor's resolved QUALITY settings (oscillator maths,
+        shaper tables, filter oversampling mode). Cheap when nothing changed. */
+    void setQuality(const Quality::Settings& settings);
+
+    /** Group delay of the filter oversampling, in samples. In Auto mode the
+        faster paths are padded to the slowest one, so this never changes
+        from block to block. */
+    float getLatencyInSamples() const noexcept { return osLatency; }
+
+    /** Stereo position for the current note, -1 (left) … +1 (right).
+        Equal-power law normalised so the centre is unity on both sides. */
+    void setPan(float pan) noexcept;
+
+    /** Mono mode: move the sounding note to midiNoteNumber over glideSeconds
+        (exponential, i.e. constant time per octave), optionally retriggering
+        the envelope. The phase increment is ramped every sample. */
+    void glideTo(int midiNoteNumber, float glideSeconds, bool retrigger) noexcept;
+
+    /** Voice-shedding hooks: a voice is sheddable once its envelope is in
+        release; shed() fades it out over a few ms and frees it. */
+    bool  isReleasing() const noexcept    { return isVoiceActive() && adsr.isReleasing() && ! adsr.isQuickReleasing(); }
+    float getEnvelopeLevel() const noexcept { return adsr.getLevel(); }
+    void  shed() noexcept                 { adsr.quickRelease(0.005f); }
+
+    /** Level of detail: a voice in release, or below −40 dB outside its
+        attack, could run the cheap path. The engine ranks the voices and
+        calls setLowDetail() before rendering; the loudest and newest stay
+        at full detail. */
+    bool  wantsLowDetail() const noexcept
+    {
+        return isVoiceActive()
+            && (adsr.isReleasing() || (adsr.getLevel() < lowDetailLevel && ! adsr.isAttacking()));
+    }
+    void  setLowDetail(bool shouldBeLow);
 
     enum
     {
@@ -35,17 +103,60 @@ public:
     };
 
 private:
+    // Internal audio util objects: Gain -> LadderFilter -> WaveShaper
+    using FilterChain = juce::dsp::ProcessorChain<juce::dsp::Gain<float>,
+                                                  juce::dsp::LadderFilter<float>,
+                                                  juce::dsp::WaveShaper<float>>;
+
+    // One filter path per oversampling factor (1×, 2×, 4×). Fixed FILTER_OS
+    // modes only ever run one of them; "Auto" picks one per block.
+    struct FilterPath
+    {
+        FilterChain chain;
+        juce::dsp::StateVariableTPTFilter<float> svf;
+        HalfBandResampler* os = nullptr;                    // running variant, nullptr at 1×
+        std::array<std::unique_ptr<HalfBandResampler>, 2> osVariants;   // min / linear phase, built in prepare()
+        int factor = 1;
+
+        // delay that pads this path to the slowest path of the current mode:
+        // whole samples from the ring, then a first-order allpass for the
+        // fraction (the 4× FIR path sits at 38.5 samples)
+        static constexpr int maxCompDelay = 64;
+        std::array<float, maxCompDelay> compRing {};
+        int   compDelay = 0, compWrite = 0;
+        float compCoef = 0.0f, compX1 = 0.0f, compY1 = 0.0f;
+        bool  compActive = false;
+    };
+
+    static constexpr int numFilterPaths = 3;
+    static constexpr int autoOsMode     = 5;   // FILTER_OS index of "Auto"
+
     //==============================================================================
     float computeOscSample();
+    float advanceLfo(int numSteps);      // advance LFO phase, returns raw −1…+1
     void updateParams();
     void configureOversampling();
+    void processFilterPath(FilterPath&, juce::dsp::AudioBlock<float>, bool useSVF);
+
+    // Fused VCA: envelope × smoothed amp-mod ramp × optional soft-clip
+    enum class VcaClip { none, exact, fast };
+    template <VcaClip clip>
+    static void vcaKernel(float* signal, const float* env, float gain0, float gainStep, int numSamples) noexcept;
+    void chooseAutoPath(float cutoffHz, float resonance);
+    void switchToPath(int pathIndex);    // crossfades if the voice is sounding
+
+    static void  applyModelVoicing(int model, FilterChain& chain);
+    static constexpr int numShaperModels = 96;   // 0 … 94 plus the fallback voicing
+    static const Quality::ShaperTableBank& modelShaperTables();
+    static float estimateShaperDrive(const std::function<float(float)>& shaper);
 
     // Members
-    juce::AudioProcessorValueTreeState& parameters;
+    //==========================================================================
+    HotState* hot = nullptr;                     // this voice's slot, set in prepare()
 
-    // Internal audio util objects: Gain -> LadderFilter -> WaveShaper
-    juce::dsp::ProcessorChain<juce::dsp::Gain<float>, juce::dsp::LadderFilter<float>, juce::dsp::WaveShaper<float>> filterChain;
-    juce::dsp::StateVariableTPTFilter<float> svFilter;
+    const VoiceParams::Block& prm;               // processor's per-block snapshot
+
+    std::array<FilterPath, numFilterPaths> filterPaths;
 
     // Smoothed parameters
     juce::LinearSmoothedValue<float> cutoffSmoothed   { 20000.0f };
@@ -81,110 +192,54 @@ private:
                             // 92=DigitalMoog   (DX7 × Moog ladder)
                             // 93=HybridLead    (Nord Lead 2 × Analog Four)
                             // 94=GlowPad       (Wavestation × SH‑101)
-    juce::ADSR adsr;
-    juce::ADSR::Parameters adsrParams;
+    AnalogEnvelope adsr;                     // block ADSR (linear or RC curves)
+    AnalogEnvelope::Parameters adsrParams;
 
     double currentSampleRate = 44100.0;
 
-    // Oscillator phase
-    double phase = 0.0;
-    float triangleIntegrator = 0.0f;   // per‐voice integrator for triangle
-
-    // NEW -----------------------------------------------------------------------
-    double phase2 = 0.0;                  // 2nd oscillator
-    float  triangleIntegrator2 = 0.0f;
-    double lfoPhase = 0.0;                // LFO phase
-    
     // Noise generator
     juce::Random rnd;
-    float noiseMix = 0.0f;   // updated each block from the parameter
-    bool  noiseOn  = false;
     
     // Performance optimizations
-    juce::AudioBuffer<float> scratchBuffer;   // reused temp buffer
+    juce::AudioBuffer<float> scratchBuffer;   // 3 channels, refers into the arena
     int previousModel = -1;                   // cache to skip switch
 
-    // Parameter pointer caches to avoid per-sample lookups
-    std::atomic<float>* wave1Param     = nullptr;
-    std::atomic<float>* wave2Param     = nullptr;
-    std::atomic<float>* pulseWidthParam= nullptr;
-    std::atomic<float>* osc1VolParam   = nullptr;
-    std::atomic<float>* osc2VolParam   = nullptr;
-    std::atomic<float>* lfoOnParam     = nullptr;
-    std::atomic<float>* lfoRateParam   = nullptr;
-    std::atomic<float>* lfoDepthParam  = nullptr;
-    std::atomic<float>* noiseOnParam   = nullptr;
-    std::atomic<float>* noiseMixParam  = nullptr;
-    std::atomic<float>* modelParam     = nullptr;
-    std::atomic<float>* cutoffParam    = nullptr;
-    std::atomic<float>* resonanceParam = nullptr;
-    std::atomic<float>* attackParam    = nullptr;
-    std::atomic<float>* decayParam     = nullptr;
-    std::atomic<float>* sustainParam   = nullptr;
-    std::atomic<float>* releaseParam   = nullptr;
-    // ===== NEW analogue-extra parameter pointers =============================
-    std::atomic<float>* freePhaseParam  = nullptr;
-    std::atomic<float>* driftParam      = nullptr;
-    std::atomic<float>* filterTolParam  = nullptr;
-    std::atomic<float>* vcaClipParam    = nullptr;
-    std::atomic<float>* analogEnvParam  = nullptr;   // NEW: sqrt envelope
-    std::atomic<float>* legatoParam     = nullptr;   // NEW: single-trigger ADSR
-    // === NEW enhancement parameter pointers ===================================
-    std::atomic<float>* enhVcaParam     = nullptr;   // VCA soft-clip
-    // === NEW detune pointers ========================================
-    std::atomic<float>* osc2SemiParam  = nullptr;
-    std::atomic<float>* osc2FineParam  = nullptr;
-    // =========================================================================
-
-    // -------- drift & tolerance state ----------------------------------------
-    double frequency    = 440.0;
-    double drift        = 0.0;
-    float  cutoffTol    = 1.0f;
-    float  resonanceTol = 1.0f;
+    // -------- drift & tolerance (ANA_DRIFT / ANA_FILT_TOL) -------------------
+    AnalogDrift analog;                      // stepped once per micro-block
+    float  pitchDrift   = 1.0f;              // frequency multiplier for this block
     // ---------------------------------------------------------------------------
 
-    // DSP-based LFO for improved multi-shape and sync
-    juce::dsp::Oscillator<float> lfoOsc;
-    double hostBpm { 120.0 };                      // current host BPM
-    std::atomic<float>* lfoSyncParam = nullptr;    // tempo-sync toggle
-    std::atomic<float>* lfoShapeParam = nullptr;   // LFO waveform shape
-    std::atomic<float>* lfoSyncDivParam = nullptr; // LFO sync division selector
-    std::atomic<float>* lfoPhaseParam = nullptr;   // LFO phase offset (0..1)
-    // === NEW : LFO routing toggles =========================================
-    std::atomic<float>* lfoToPitchParam  = nullptr;
-    std::atomic<float>* lfoToCutoffParam = nullptr;
-    std::atomic<float>* lfoToAmpParam    = nullptr;
-    float               lastLfoValue     = 0.0f;   // raw LFO sample (-1…+1)
+    double hostBpm { 120.0 };                      // current host BPM (LFO sync)
     juce::LinearSmoothedValue<float> ampModSmoothed; // Smoothing for Amp LFO
-    // -----------------------------------------------------------------------
-    int previousLfoShape = -1;                    // cache last applied LFO shape
 
     // ===== Oversampling (filter path) =====================================
-    std::unique_ptr<juce::dsp::Oversampling<float>> oversampler; // nullptr when OS off
-    std::atomic<float>* osModeParam = nullptr;   // pointer to FILTER_OS parameter
+    int    requestedOsMode      = 0;             // FILTER_OS index from the QUALITY tier
     int    currentOsMode        = -1;            // cache selected mode (0=off)
-    int    samplesPerBlockCached = 0;            // saved for oversampler init
-
-    // Cached per-block oscillator parameters
-    int   cachedWf1 = 0, cachedWf2 = 0;
-    float cachedPw = 0.0f, cachedVol1 = 0.0f, cachedVol2 = 0.0f;
-
-    // Cached per-block LFO and noise parameters
-    bool  cachedLfoOn = false;
-    float cachedLfoRate = 0.0f;
-    float cachedLfoDepthParam = 0.0f;
-    bool  cachedLfoSync = false;
-    int   cachedLfoSyncDiv = 2;
-    int   cachedLfoShape = 0;
-    float cachedLfoPhaseOffset = 0.0f;
-    bool  cachedLfoToPitch = false;
-    bool  cachedLfoToCutoff = false;
-    bool  cachedLfoToAmp = false;
-    bool  cachedNoiseOn = false;
-    float cachedNoiseMix = 0.0f;
-    double cachedDetuneRatio = 1.0; // cached 2nd-osc detune ratio
-
-    void cacheOscParams();
+    int    activePath           = 0;             // index into filterPaths
+    int    fixedPath            = 0;             // path of a fixed FILTER_OS mode
+    float  osLatency            = 0.0f;          // reported latency of the current mode
+
+    // ----- Auto mode: per-block factor choice with a short crossfade -------
+    bool   autoOs               = false;
+    int    fadeFromPath         = -1;            // path being faded out (-1 = none)
+    int    fadeSamplesTotal     = 0;
+    int    fadeSamplesRemaining = 0;
+    float  modelDrive           = 0.0f;          // 0 = linear shaper … ~0.4 = hard tanh
+
+    // ----- Level of detail (release tails / quiet voices) --------------------
+    static constexpr float lowDetailLevel = 0.01f;   // −40 dB envelope
+    bool   lowDetail            = false;
+    bool   lfoControlRate       = false;         // LFO stepped once per block
+    std::function<float(float)> fullShaper;      // model (or table) shaper to restore
+    std::function<float(float)> detailShaper;    // what low detail runs: the model's table
+
+    // ----- Stereo placement (set by the engine at note-on) -----------------
+    float  panGainL             = 1.0f;
+    float  panGainR             = 1.0f;
+
+    // ----- QUALITY tier -----------------------------------------------------
+    bool   fastOsc              = false;         // table sine, rational tanh
+    int    shaperTablePoints    = 0;             // 0 = exact model shaper
 
     JUCE_DECLARE_NON_COPYABLE_WITH_LEAK_DETECTOR(SynthVoice)
 }; 
\ No newline at end of file
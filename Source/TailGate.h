@@ -0,0 +1,59 @@
+#pragma once
+#include <JuceHeader.h>
+
+//==============================================================================
+// Silence tracking for an FX stage that has memory (delay, reverb, the post
+// chain).
+//
+// A stage goes idle once its input has been silent and its output below the
+// threshold for `hold` samples in a row. The hold must cover the longest
+// gap the stage can leave between two bursts of output (a delay's echo
+// spacing, a tank's longest loop), or a quiet stretch between repeats would
+// cut the tail short. While idle and fed silence the stage would only output
+// silence, so the caller skips it; any input above the threshold wakes it.
+//==============================================================================
+class TailGate
+{
+public:
+    static constexpr float silenceThreshold = 3.1623e-5f;   // -90 dBFS
+
+    static bool isSilent (const juce::AudioBuffer<float>& b) noexcept
+    {
+        return b.getMagnitude (0, b.getNumSamples()) < silenceThreshold;
+    }
+
+    void setHoldSamples (juce::int64 n) noexcept { hold = n; }
+
+    /** Before the stage: false while idle and the input is silent (skip it). */
+    bool shouldProcess (bool inputSilent) noexcept
+    {
+        if (! inputSilent)
+            wake();
+        return ! idle;
+    }
+
+    /** After the stage. True on the block it goes idle, so the caller can
+        clear the stage's state once rather than leave a residue behind. */
+    bool update (bool inputSilent, bool outputSilent, int numSamples) noexcept
+    {
+        if (! inputSilent || ! outputSilent)
+        {
+            quiet = 0;
+            return false;
+        }
+
+        quiet += numSamples;
+        if (idle || quiet < hold)
+            return false;
+
+        idle = true;
+        return true;
+    }
+
+    void wake() noexcept          { quiet = 0; idle = false; }
+    bool isIdle() const noexcept  { return idle; }
+
+private:
+    juce::int64 hold = 0, quiet = 0;
+    bool idle = false;
+};
@@ -0,0 +1,162 @@
+#pragma once
+#include <JuceHeader.h>
+#include <atomic>
+#include <cmath>
+
+//==============================================================================
+// Parameters every SynthVoice reads, held once by the processor.
+//
+// The raw APVTS pointers are cold: looked up once in attach() and touched
+// only by update(), which runs once per processBlock and snapshots them into
+// `block`. Voices keep a const reference and read the snapshot, so eight
+// voices share one small, read-only set of cache lines instead of each
+// carrying ~35 pointers and its own copy of the cached values.
+//==============================================================================
+struct VoiceParams
+{
+    // Per-block snapshot (what the voices actually read)
+    struct Block
+    {
+        // oscillators
+        int    wf1 = 0, wf2 = 0;
+        float  pulseWidth = 0.0f, vol1 = 0.0f, vol2 = 0.0f;
+        double detuneRatio = 1.0;            // 2nd-osc semi + fine
+        bool   noiseOn = false;
+        float  noiseMix = 0.0f;
+
+        // LFO
+        bool   lfoOn = false, lfoSync = false;
+        float  lfoRate = 0.0f, lfoDepth = 0.0f, lfoPhaseOffset = 0.0f;
+        int    lfoSyncDiv = 2, lfoShape = 0;
+        bool   lfoToPitch = false, lfoToCutoff = false, lfoToAmp = false;
+
+        // filter / envelope / VCA
+        int    model = 0;
+        float  cutoff = 20000.0f, resonance = 0.7f;
+        float  attack = 0.1f, decay = 0.1f, sustain = 1.0f, release = 0.1f;
+        bool   analogEnv = false, enhVca = false;
+
+        // note-on behaviour
+        bool   legato = false, freePhase = false;
+
+        // analogue character
+        bool   drift = false, filterTol = false;
+    };
+
+    Block block;
+
+    void attach (juce::AudioProcessorValueTreeState& vts)
+    {
+        // update() reads every pointer unchecked, so each ID must exist
+        auto param = [&vts] (const char* id)
+        {
+            auto* p = vts.getRawParameterValue (id);
+            jassert (p != nullptr);
+            return p;
+        };
+
+        wave1       = param ("WAVEFORM");
+        wave2       = param ("WAVEFORM2");
+        pulseWidth  = param ("PULSE_WIDTH");
+        osc1Vol     = param ("OSC1_VOLUME");
+        osc2Vol     = param ("OSC2_VOLUME");
+        osc2Semi    = param ("OSC2_SEMI");
+        osc2Fine    = param ("OSC2_FINE");
+        noiseOn     = param ("NOISE_ON");
+        noiseMix    = param ("NOISE_MIX");
+        lfoOn       = param ("LFO_ON");
+        lfoRate     = param ("LFO_RATE");
+        lfoDepth    = param ("LFO_DEPTH");
+        lfoSync     = param ("LFO_SYNC");
+        lfoSyncDiv  = param ("LFO_SYNC_DIV");
+        lfoShape    = param ("LFO_SHAPE");
+        lfoPhase    = param ("LFO_PHASE");
+        lfoToPitch  = param ("LFO_TO_PITCH");
+        lfoToCutoff = param ("LFO_TO_CUTOFF");
+        lfoToAmp    = param ("LFO_TO_AMP");
+        model       = param ("MODEL");
+        cutoff      = param ("CUTOFF");
+        resonance   = param ("RESONANCE");
+        attack      = param ("ATTACK");
+        decay       = param ("DECAY");
+        sustain     = param ("SUSTAIN");
+        release     = param ("RELEASE");
+        analogEnv   = param ("ANA_ENV");
+        enhVca      = param ("ENH_VCA");
+        legato      = param ("ANA_LEGATO");
+        freePhase   = param ("ANA_FREE");
+        drift       = param ("ANA_DRIFT");
+        filterTol   = param ("ANA_FILT_TOL");
+    }
+
+    /** Snapshot the parameters for this block. Audio thread, before rendering. */
+    void update() noexcept
+    {
+        auto& b = block;
+        b.wf1        = int (wave1->load());
+        b.wf2        = int (wave2->load());
+        b.pulseWidth = pulseWidth->load();
+        b.vol1       = osc1Vol->load();
+        b.vol2       = osc2Vol->load();
+
+        const float semi = osc2Semi->load(), fine = osc2Fine->load();
+        if (semi != lastSemi || fine != lastFine)     // pow only when detune moves
+        {
+            lastSemi      = semi;
+            lastFine      = fine;
+            b.detuneRatio = std::pow (2.0, (semi + fine * 0.01f) / 12.0);
+        }
+
+        b.noiseOn        = noiseOn->load() > 0.5f;
+        b.noiseMix       = noiseMix->load();
+
+        b.lfoOn          = lfoOn->load() > 0.5f;
+        b.lfoRate        = lfoRate->load();
+        b.lfoDepth       = lfoDepth->load();
+        b.lfoSync        = lfoSync->load() > 0.5f;
+        b.lfoSyncDiv     = int (lfoSyncDiv->load());
+        b.lfoShape       = int (lfoShape->load());
+        b.lfoPhaseOffset = lfoPhase->load();
+        b.lfoToPitch     = lfoToPitch->load() > 0.5f;
+        b.lfoToCutoff    = lfoToCutoff->load() > 0.5f;
+        b.lfoToAmp       = lfoToAmp->load() > 0.5f;
+
+        b.model          = int (model->load());
+        b.cutoff         = cutoff->load();
+        b.resonance      = resonance->load();
+        b.attack         = attack->load();
+        b.decay          = decay->load();
+        b.sustain        = sustain->load();
+        b.release        = release->load();
+        b.analogEnv      = analogEnv->load() > 0.5f;
+        b.enhVca         = enhVca->load() > 0.5f;
+
+        b.legato         = legato->load() > 0.5f;
+        b.freePhase      = freePhase->load() > 0.5f;
+        b.drift          = drift->load() > 0.5f;
+        b.filterTol      = filterTol->load() > 0.5f;
+    }
+
+private:
+    std::atomic<float>* wave1 = nullptr;  std::atomic<float>* wave2 = nullptr;
+    std::atomic<float>* pulseWidth = nullptr;
+    std::atomic<float>* osc1Vol = nullptr;  std::atomic<float>* osc2Vol = nullptr;
+    std::atomic<float>* osc2Semi = nullptr; std::atomic<float>* osc2Fine = nullptr;
+    std::atomic<float>* noiseOn = nullptr;  std::atomic<float>* noiseMix = nullptr;
+    std::atomic<float>* lfoOn = nullptr;    std::atomic<float>* lfoRate = nullptr;
+    std::atomic<float>* lfoDepth = nullptr; std::atomic<float>* lfoSync = nullptr;
+    std::atomic<float>* lfoSyncDiv = nullptr; std::atomic<float>* lfoShape = nullptr;
+    std::atomic<float>* lfoPhase = nullptr;
+    std::atomic<float>* lfoToPitch = nullptr; std::atomic<float>* lfoToCutoff = nullptr;
+    std::atomic<float>* lfoToAmp = nullptr;
+    std::atomic<float>* model = nullptr;
+    std::atomic<float>* cutoff = nullptr;   std::atomic<float>* resonance = nullptr;
+    std::atomic<float>* attack = nullptr;   std::atomic<float>* decay = nullptr;
+    std::atomic<float>* sustain = nullptr;  std::atomic<float>* release = nullptr;
+    std::atomic<float>* analogEnv = nullptr; std::atomic<float>* enhVca = nullptr;
+    std::atomic<float>* legato = nullptr;
+    std::atomic<float>* freePhase = nullptr; std::atomic<float>* drift = nullptr;
+    std::atomic<float>* filterTol = nullptr;
+
+    float lastSemi = -1000.0f, lastFine = -1000.0f;
+};